@@ -0,0 +1,332 @@
+#include "bench.h"
+
+#ifdef BENCH
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/pgmspace.h>
+#include <avr/sleep.h>
+#include "dcf77.h"
+#include "display.h"
+#include "pwm.h"
+#include "ticks.h"
+
+#define BENCH_BAUD      38400
+#define BENCH_UBRR      ((F_CPU / (8L * BENCH_BAUD)) - 1)
+
+/* Messwerte einer Funktion [Takte] */
+typedef struct
+{
+    uint16_t min, max;
+    uint32_t sum;
+    uint16_t count;
+} BenchStat;
+
+/* ISRs sichern alle benutzten Register und lassen sich wie Funktionen aufrufen */
+extern "C" void TIMER0_OVF_vect(void);
+extern "C" void TIMER1_COMPB_vect(void);
+extern "C" void TIMER1_COMPA_vect(void);
+extern "C" void TIMER2_OVF_vect(void);
+
+/* DCF-Abtastung (dcf77.h) */
+#ifdef DCF_SAMPLE_TIMER1
+#define BENCH_DCF_ISR   TIMER1_COMPB_vect
+#else
+#define BENCH_DCF_ISR   TIMER0_OVF_vect
+#endif
+
+static uint16_t bench_overhead;         // Takte der leeren Messung
+
+/* Misst die Takte von call (Timer1 läuft mit Vorteiler 1).
+   Nach ISR-Aufrufen die Interrupts wieder sperren (reti setzt das I-Bit) */
+#define BENCH_MEASURE(stat, call)                       \
+    do {                                                \
+        uint16_t bench_t0 = TCNT1;                      \
+        call;                                           \
+        uint16_t bench_t = TCNT1 - bench_t0;            \
+        cli();                                          \
+        bench_add(&(stat), bench_t - bench_overhead);   \
+    } while (0)
+
+/* Minutenrahmen 12:34 MEZ, 1.1. (20)26; Sekunde 59 ohne Impuls */
+static uint8_t bench_dcf[8];
+
+static void bench_add(BenchStat *s, uint16_t cycles)
+{
+    if (s->count == 0 || cycles < s->min)
+        s->min = cycles;
+    if (cycles > s->max)
+        s->max = cycles;
+    s->sum += cycles;
+    s->count++;
+}
+
+static void bench_put(char c)
+{
+    while (!(UCSRA & (1 << UDRE)));
+    UDR = c;
+}
+
+static void bench_puts_P(const char *s)
+{
+    char c;
+
+    while ((c = pgm_read_byte(s++)))
+        bench_put(c);
+}
+
+static void bench_number(uint32_t value)
+{
+    char buf[10];
+    uint8_t n = 0;
+
+    do
+    {
+        buf[n++] = '0' + value % 10;
+        value /= 10;
+    } while (value);
+    bench_put(' ');
+    while (n)
+        bench_put(buf[--n]);
+}
+
+/* Gibt eine Messung aus und setzt sie zurück (Namen im Flash, suffix darf 0 sein) */
+static void bench_print(const char *name, const char *suffix, BenchStat *s)
+{
+    bench_puts_P(PSTR("BENCH "));
+    bench_puts_P(name);
+    if (suffix)
+        bench_puts_P(suffix);
+    bench_number(s->min);
+    bench_number(s->count ? s->sum / s->count : 0);
+    bench_number(s->max);
+    bench_put('\n');
+    *s = (BenchStat){ 0, 0, 0, 0 };
+}
+
+/* Setzt value als BCD ab Bit first (count Bits) und liefert die Anzahl Einsen */
+static uint8_t bench_bcd(uint8_t first, uint8_t count, uint8_t value)
+{
+    static const uint8_t weight[] PROGMEM = { 1, 2, 4, 8, 10, 20, 40, 80 };
+    uint8_t i, w, ones = 0;
+
+    for (i = count; i-- > 0; )
+    {
+        w = pgm_read_byte(&weight[i]);
+        if (value >= w)
+        {
+            value -= w;
+            bench_dcf[(first + i) >> 3] |= 1 << ((first + i) & 7);
+            ones++;
+        }
+    }
+    return ones;
+}
+
+static void bench_bit(uint8_t bit)
+{
+    bench_dcf[bit >> 3] |= 1 << (bit & 7);
+}
+
+static void bench_dcf_frame(void)
+{
+    uint8_t ones;
+
+    bench_bit(18);                      // MEZ
+    bench_bit(20);                      // Beginn der Zeitinformation
+    if (bench_bcd(21, 7, 34) & 1)
+        bench_bit(28);
+    if (bench_bcd(29, 6, 12) & 1)
+        bench_bit(35);
+    ones = bench_bcd(36, 6, 1);         // Tag
+    ones += bench_bcd(42, 3, 4);        // Wochentag (Donnerstag)
+    ones += bench_bcd(45, 5, 1);        // Monat
+    ones += bench_bcd(50, 8, 26);       // Jahr
+    if (ones & 1)
+        bench_bit(58);
+}
+
+/* DCF-Abtastung: zwei Minuten Signal, je DCF_SAMPLE_MS ein Aufruf der ISR */
+static void bench_dcf77(void)
+{
+    BenchStat isr = { 0, 0, 0, 0 }, process = { 0, 0, 0, 0 };
+    uint8_t minute, second, h, m;
+    uint16_t sample, pulse;
+
+    DCF_DDR |= (1 << 0);                // PD0 als Ausgang: PIND liest den Ausgangswert
+    for (minute = 0; minute < 2; minute++)
+    {
+        for (second = 0; second < 60; second++)
+        {
+            pulse = 0;
+            if (second < 59)
+                pulse = (bench_dcf[second >> 3] & (1 << (second & 7))) ? 200 / DCF_SAMPLE_MS : 100 / DCF_SAMPLE_MS;
+            for (sample = 0; sample < 1000 / DCF_SAMPLE_MS; sample++)
+            {
+                if (sample < pulse)
+                    DCF_PORT |= (1 << 0);
+                else
+                    DCF_PORT &= ~(1 << 0);
+                BENCH_MEASURE(isr, BENCH_DCF_ISR());
+                BENCH_MEASURE(process, dcf_process());
+            }
+        }
+    }
+    /* Erste Flanke der folgenden Minute: Minutenmarke, Rahmen vollständig */
+    DCF_PORT |= (1 << 0);
+    BENCH_MEASURE(isr, BENCH_DCF_ISR());
+    BENCH_MEASURE(process, dcf_process());
+    DCF_PORT &= ~(1 << 0);
+    DCF_DDR &= ~(1 << 0);
+
+    bench_print(PSTR("dcf_isr"), 0, &isr);
+    bench_print(PSTR("dcf_process"), 0, &process);
+    dcf_getTime(&h, &m);
+    bench_puts_P((h == 12 && m == 34) ? PSTR("BENCH dcf_decode ok\n") : PSTR("BENCH dcf_decode FAIL\n"));
+}
+
+static void bench_timer2(void)
+{
+    BenchStat isr = { 0, 0, 0, 0 };
+    uint8_t i;
+
+    for (i = 0; i < 100; i++)
+        BENCH_MEASURE(isr, TIMER2_OVF_vect());
+    bench_print(PSTR("timer2_isr"), 0, &isr);
+}
+
+/* Muster für pwm_update(): Werte je Kanal (PWM-Schritte) */
+static const uint8_t bench_patterns[][PWM_CHANNELS] PROGMEM =
+{
+    { 19, 19, 19 },                     // alle gleich (eine Flanke)
+    { 12, 19, 25 },                     // aufsteigend
+    { 25, 19, 12 },                     // absteigend
+    { 13, 24, 18 },                     // gemischt
+    { 0, 18, 0 }                        // ein Kanal aktiv
+};
+static const char bench_pattern_names[][8] PROGMEM =
+{
+    "equal", "rising", "falling", "mixed", "single"
+};
+
+static void bench_pwm(void)
+{
+    BenchStat update = { 0, 0, 0, 0 }, isr = { 0, 0, 0, 0 };
+    uint8_t values[PWM_CHANNELS];
+    uint8_t p, ch, i;
+
+    /* Erster Aufruf startet die PWM (Timer1 mit Vorteiler 8, Compare-
+       Interrupt an); danach Timer1 wieder als Taktzähler, Interrupt aus */
+    for (ch = 0; ch < PWM_CHANNELS; ch++)
+        values[ch] = 19;
+    set_pwm(values);
+    TIMSK &= ~(1 << OCIE1A);
+    TCCR1B = (1 << CS10);
+
+    for (p = 0; p < sizeof(bench_patterns) / sizeof(bench_patterns[0]); p++)
+    {
+        for (ch = 0; ch < PWM_CHANNELS; ch++)
+            values[ch] = pgm_read_byte(&bench_patterns[p][ch]);
+        for (i = 0; i < 20; i++)
+            BENCH_MEASURE(update, set_pwm(values));
+        bench_print(PSTR("pwm_update_"), bench_pattern_names[p], &update);
+
+        /* ISR über mehrere Zyklen mit diesem Muster (Übernahme am Zyklusende);
+           hält sie Timer1 an (pwm_stop), läuft er als Taktzähler weiter */
+        for (i = 0; i < 5 * (PWM_CHANNELS + 1); i++)
+        {
+            BENCH_MEASURE(isr, TIMER1_COMPA_vect());
+            TIMSK &= ~(1 << OCIE1A);
+            TCCR1B = (1 << CS10);
+        }
+    }
+    bench_print(PSTR("timer1_compa_isr"), 0, &isr);
+}
+
+#ifdef DISPLAY_BCM
+/* Helligkeitsstufen der Anzeige (display.h): TIMER0_OVF_vect über zwei
+   Zyklen je Stufe mit angehaltenem Timer0; die Dauer eines Abschnitts ist
+   der Abstand, um den die ISR TCNT0 vor den Überlauf stellt. Je Stufe eine
+   Zeile DISPLAY <Stufe> <Interrupts/s> <Last ppm> <Tastgrad ‰> <µA je LED>
+   (Stufe 0 und voll ohne Interrupt) */
+static void bench_display(void)
+{
+    BenchStat isr = { 0, 0, 0, 0 }, level = { 0, 0, 0, 0 };
+    uint16_t on, total;
+    uint8_t l, i, len;
+
+    display_show(0x17, 0x3B);
+    for (l = 1; l < DISPLAY_FULL; l++)
+    {
+        display_level(l);
+        TIMSK &= ~(1 << TOIE0);
+        TCCR0 = 0;
+        on = total = 0;
+        for (i = 0; i < 2 * DISPLAY_BITS; i++)
+        {
+            TCNT0 = 0;
+            BENCH_MEASURE(level, TIMER0_OVF_vect());
+            len = -TCNT0;
+            total += len;
+            if (PORTC & ~PWM_MASK_C)
+                on += len;
+        }
+        /* Zyklus = total / 2 Ticks zu 64 Takten */
+        uint32_t irq = (uint32_t)F_CPU / 64 * (2 * DISPLAY_BITS) / total;
+        uint16_t duty = (uint32_t)on * 1000 / total;
+        bench_puts_P(PSTR("DISPLAY"));
+        bench_number(l);
+        bench_number(irq);
+        bench_number((level.sum / level.count) * irq / (F_CPU / 1000000UL));
+        bench_number(duty);
+        bench_number((uint32_t)DISPLAY_LED_MA * duty);
+        bench_put('\n');
+        if (isr.count == 0 || level.min < isr.min)
+            isr.min = level.min;
+        if (level.max > isr.max)
+            isr.max = level.max;
+        isr.sum += level.sum;
+        isr.count += level.count;
+        level = (BenchStat){ 0, 0, 0, 0 };
+    }
+    display_level(0);
+    bench_print(PSTR("display_isr"), 0, &isr);
+}
+#endif
+
+void bench_run(void)
+{
+    uint16_t t0;
+
+    cli();
+    TIMSK = 0;
+    UBRRH = (uint8_t)(BENCH_UBRR >> 8);
+    UBRRL = (uint8_t)BENCH_UBRR;
+    UCSRA = (1 << U2X);
+    UCSRC = (1 << URSEL) | (1 << UCSZ1) | (1 << UCSZ0);
+    UCSRB = (1 << TXEN);
+
+    /* Timer1 als Taktzähler; Kosten der leeren Messung bestimmen */
+    TCCR1A = 0;
+    TCCR1B = (1 << CS10);
+    t0 = TCNT1;
+    bench_overhead = TCNT1 - t0;
+
+    pwm_init();
+    bench_dcf_frame();
+    bench_dcf77();
+    bench_timer2();
+    bench_pwm();
+#ifdef DISPLAY_BCM
+    bench_display();
+#endif
+
+    bench_puts_P(PSTR("BENCH end\n"));
+    while (!(UCSRA & (1 << UDRE)));
+    set_sleep_mode(SLEEP_MODE_IDLE);
+    sleep_enable();
+    for (;;)
+        sleep_cpu();                    // gesperrte Interrupts: simavr beendet sich
+}
+
+#endif // BENCH
@@ -0,0 +1,30 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+/* Messlauf für die Laufzeit (nur mit -DBENCH, Auswertung mit
+   tools/bench/run.sh unter simavr). Statt des Uhrbetriebs ruft main()
+   bench_run() auf; gemessen wird mit Timer1 ohne Vorteiler (ein Tick =
+   ein Takt) bei gesperrten Interrupts:
+   - DCF-Abtastung (TIMER0_OVF_vect bzw. TIMER1_COMPB_vect) und dcf_process() über zwei DCF-Minuten (12:34 MEZ),
+     das DCF-Signal wird dazu über PD0 als Ausgang erzeugt
+   - TIMER2_OVF_vect (RTC-Sekunde)
+   - pwm_update() über set_pwm() mit festen Mustern
+   - TIMER1_COMPA_vect über mehrere PWM-Zyklen
+   - mit DISPLAY_BCM: TIMER0_OVF_vect (Helligkeit der Anzeige) je Stufe,
+     dazu Zeilen DISPLAY <Stufe> <Interrupts/s> <Last ppm> <Tastgrad ‰> <µA je LED>
+   ISRs werden direkt aufgerufen: die Zeit enthält Prolog und Epilog, aber
+   nicht den Einsprung über die Vektortabelle (ca. 7 Takte).
+
+   Ausgabe über TXD (38400 Baud, 8N1), je Messung eine Zeile
+     BENCH <name> <min> <mittel> <max>
+   danach "BENCH end"; anschließend schläft die CPU mit gesperrten
+   Interrupts (simavr beendet sich dann). */
+
+#ifdef BENCH
+
+/* Führt alle Messungen aus und kehrt nicht zurück */
+void bench_run(void) __attribute__((noreturn));
+
+#endif // BENCH
+
+#endif // BENCH_H
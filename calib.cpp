@@ -0,0 +1,139 @@
+#include "calib.h"
+#include <avr/eeprom.h>
+#include <util/crc16.h>
+#include <stddef.h>
+
+/* Abbild im EEPROM */
+typedef struct
+{
+    uint8_t  version;
+    uint16_t us[SERVO_COUNT][CAL_KNOTS];
+    uint8_t  crc;                       // CRC-8 über version und us
+} CalEeprom;
+
+static CalEeprom cal_eeprom EEMEM;
+
+/* Abbild im RAM (maßgeblich) und nächstes zu schreibendes Byte */
+static CalEeprom cal_image;
+static uint8_t cal_pending = sizeof(CalEeprom);
+
+/* Stützstellen in PWM-Schritten, Format Q8 */
+static uint16_t cal_steps[SERVO_COUNT][CAL_KNOTS];
+
+/* Zeit eines PWM-Schritts in CPU-Takten */
+#define CAL_STEP_CYCLES     ((uint32_t)T_PWM * PWM_PRESCALER)
+
+/* µs -> PWM-Schritte Q8 (nur beim Laden und Ändern, nicht im laufenden Betrieb) */
+static uint16_t cal_us_to_q8(uint16_t us)
+{
+    uint32_t cycles = (uint32_t)us * (F_CPU / 1000L) / 1000L;
+
+    return (uint16_t)((cycles * 256 + CAL_STEP_CYCLES / 2) / CAL_STEP_CYCLES);
+}
+
+/* Lineare Zuordnung wie früher in servo_angle_to_pwm() */
+static uint16_t cal_linear_us(uint8_t knot)
+{
+    return MIN_PULSE_WIDTH + (uint16_t)(((uint32_t)knot * (MAX_PULSE_WIDTH - MIN_PULSE_WIDTH)
+                                         << CAL_SHIFT) / 180);
+}
+
+static uint8_t cal_crc(const CalEeprom *image)
+{
+    const uint8_t *p = (const uint8_t *)image;
+    uint8_t crc = 0;
+    uint8_t i;
+
+    for (i = 0; i < offsetof(CalEeprom, crc); i++)
+        crc = _crc8_ccitt_update(crc, p[i]);
+    return crc;
+}
+
+/* Lineare Zuordnung ins Abbild und in die Stützstellen */
+static void cal_linear(void)
+{
+    uint8_t ch, k;
+
+    cal_image.version = CAL_VERSION;
+    for (ch = 0; ch < SERVO_COUNT; ch++)
+    {
+        for (k = 0; k < CAL_KNOTS; k++)
+        {
+            cal_image.us[ch][k] = cal_linear_us(k);
+            cal_steps[ch][k] = cal_us_to_q8(cal_linear_us(k));
+        }
+    }
+    cal_image.crc = cal_crc(&cal_image);
+}
+
+void cal_load(void)
+{
+    uint8_t ch, k;
+
+    eeprom_read_block(&cal_image, &cal_eeprom, sizeof(cal_image));
+    cal_pending = sizeof(cal_image);
+    if (cal_image.version != CAL_VERSION || cal_image.crc != cal_crc(&cal_image))
+    {
+        cal_linear();                   // nur im RAM, das EEPROM bleibt ungültig
+        return;
+    }
+    for (ch = 0; ch < SERVO_COUNT; ch++)
+    {
+        for (k = 0; k < CAL_KNOTS; k++)
+            cal_steps[ch][k] = cal_us_to_q8(cal_image.us[ch][k]);
+    }
+}
+
+void cal_reset(void)
+{
+    cal_linear();
+    cal_pending = 0;
+}
+
+void cal_set(uint8_t ch, uint8_t knot, uint16_t us)
+{
+    if (ch >= SERVO_COUNT || knot >= CAL_KNOTS)
+        return;
+    cal_image.us[ch][knot] = us;
+    cal_image.crc = cal_crc(&cal_image);
+    cal_steps[ch][knot] = cal_us_to_q8(us);
+    cal_pending = 0;                    // von vorn: die CRC wird zuletzt geschrieben
+}
+
+void cal_idle(void)
+{
+    const uint8_t *p = (const uint8_t *)&cal_image;
+    uint8_t *e = (uint8_t *)&cal_eeprom;
+
+    while (cal_pending < sizeof(cal_image))
+    {
+        if (!eeprom_is_ready())
+            return;
+        if (eeprom_read_byte(e + cal_pending) != p[cal_pending])
+        {
+            eeprom_write_byte(e + cal_pending, p[cal_pending]);
+            cal_pending++;
+            return;
+        }
+        cal_pending++;                  // unverändert, kostet keinen Schreibzyklus
+    }
+}
+
+uint16_t cal_get(uint8_t ch, uint8_t knot)
+{
+    return cal_image.us[ch][knot];
+}
+
+uint8_t cal_pwm(uint8_t ch, uint8_t angle)
+{
+    const uint16_t *s;
+    uint16_t q;
+    uint8_t f;
+
+    if (angle > 180)
+        angle = 180;
+    s = &cal_steps[ch][angle >> CAL_SHIFT];
+    f = angle & ((1 << CAL_SHIFT) - 1);
+    q = s[0] + (int16_t)(((int32_t)(int16_t)(s[1] - s[0]) * f) >> CAL_SHIFT);
+    return (uint8_t)((q + 128) >> 8);
+}
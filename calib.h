@@ -0,0 +1,47 @@
+#ifndef CALIB_H
+#define CALIB_H
+
+#include <stdint.h>
+#include "servo.h"
+
+/* Kalibrierung der Servos: je Kanal eine stückweise lineare Kennlinie
+   Winkel -> Pulsbreite mit Stützstellen im Abstand von 32° (0, 32 .. 192°).
+   Die Kennlinien liegen im EEPROM (in µs) und werden beim Start in eine
+   kompakte Form in PWM-Schritten (Q8) geladen. Die Abbildung kostet damit
+   unabhängig vom Winkel nur eine Multiplikation und keine Division.
+   Ohne gültige Daten im EEPROM gilt die lineare Zuordnung zwischen
+   MIN_PULSE_WIDTH und MAX_PULSE_WIDTH.
+
+   Änderungen wirken sofort (Abbild im RAM); ins EEPROM schreibt sie
+   cal_idle() nach und nach, ein Byte je Aufruf und nur, wenn das EEPROM
+   bereit ist (ca. 8,5 ms je Byte). Keine Funktion wartet so auf das
+   EEPROM, auch nicht beim Zeichnen vom PC aus.
+
+   Abgleich am Gerät ohne neues Flashen: Rahmen LINK_CAL (link.h), z. B.
+   mit tools/linkhost.cpp Zeilen "k <kanal> <stützstelle> <µs>" und
+   dazwischen "s ..." zum Anfahren des Prüfwinkels. */
+#define CAL_SHIFT       5               // Stützstellenabstand 1 << CAL_SHIFT Grad
+#define CAL_KNOTS       ((180 >> CAL_SHIFT) + 2)
+#define CAL_VERSION     1               // Kennung des EEPROM-Formats
+
+/* Lädt die Kennlinien aus dem EEPROM (lineare Zuordnung, falls ungültig) */
+void cal_load(void);
+
+/* Setzt die lineare Zuordnung für alle Kanäle (gespeichert mit cal_idle()) */
+void cal_reset(void);
+
+/* Ändert eine Stützstelle (Pulsbreite in µs), gespeichert mit cal_idle().
+   Wirksam mit dem nächsten servo_move() */
+void cal_set(uint8_t ch, uint8_t knot, uint16_t us);
+
+/* Im Leerlauf und beim Zeichnen vom PC aus aufrufen: schreibt höchstens
+   ein Byte ausstehender Änderungen ins EEPROM, blockiert nie */
+void cal_idle(void);
+
+/* Pulsbreite einer Stützstelle in µs */
+uint16_t cal_get(uint8_t ch, uint8_t knot);
+
+/* Winkel [0..180°] -> PWM-Wert nach der Kennlinie des Kanals ch */
+uint8_t cal_pwm(uint8_t ch, uint8_t angle);
+
+#endif // CALIB_H
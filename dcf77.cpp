@@ -1,5 +1,9 @@
 #include "dcf77.h"
+#include "isrstat.h"
+#include "trace.h"
+#include "stats.h"
 #include <util/delay.h>  // _delay_ms falls benötigt
+#include <string.h>
 
 /* Globales DCF77-Ereignis – wird von der ISR gesetzt */
 volatile DCFEvent dcfEvent = DCF_NONE;
@@ -8,65 +12,354 @@ volatile DCFEvent dcfEvent = DCF_NONE;
 static volatile uint8_t dcf_sync = 0;    // 0 = out of sync, 1 = synchronisiert
 static volatile uint8_t dcf_hours = 0;     // dekodierte Stunde
 static volatile uint8_t dcf_minutes = 0;   // dekodierte Minute
+static volatile uint8_t dcf_second = 0;    // Sekunde der Minute bei der Übernahme
+static volatile uint8_t dcf_fraction = 0;  // und deren Anteil (1/256 s)
 
-/* Für Timer0: Berechnung des Preload-Wertes (10 ms Periode, Prescaler 1024)
-   (Vorausgesetzt F_CPU ist extern definiert) */
+/* Vorzeitige Übernahme nach Bit 35 (dcf_expect): erwartete Minute des Tages
+   und zulässige Abweichung, 0 = aus */
+static uint16_t dcf_expect_minute;
+static uint8_t dcf_expect_window;
+
+/* Neuer Empfang (init_TCNT0_DCF, dcf_expect): dcf_process() verwirft
+   Bitnummer und Rahmen, bevor es das nächste Ereignis auswertet */
+static uint8_t dcf_restarted = 1;
+
+/* Empfangsqualität (dcf77.h); die Impulsbreiten zählt die ISR, alles
+   andere das Hauptprogramm */
+DcfQuality dcf_quality;
+static uint8_t dcf_quality_pos = 0xFF;  // Sekunden seit der letzten Minutenmarke, 0xFF = unbekannt
+
+/* Sekundenanteil beim Ereignis eines Bits: es wird an Schwelle DCF_T4 gemeldet */
+#define DCF_BIT_FRACTION ((uint8_t)((uint32_t)DCF_T4_MS * 256 / 1000))
+
+/* Verwirft das noch nicht ausgewertete Ereignis und den Stand von
+   dcf_process(): eine Bitnummer aus einem früheren Empfang darf nach dem
+   Einschalten weder die vorzeitige Übernahme noch die Minutenmarke auslösen */
+static void dcf_restart(void)
+{
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        dcfEvent = DCF_NONE;
+    }
+    dcf_restarted = 1;
+}
+
+#if (10 % DCF_SAMPLE_MS) != 0
+#error "DCF_SAMPLE_MS muss 1, 2, 5 oder 10 sein"
+#endif
+
+/* Für Timer0: Prescaler und Preload-Wert für die Abtastperiode (Vorausgesetzt
+   F_CPU ist extern definiert). Gewählt wird der größte Prescaler, bei dem der
+   durch Abrunden verlorene Rest unter 1 % der Periode bleibt */
+#define DCF_CYCLES ((F_CPU / 1000) * DCF_SAMPLE_MS)    // CPU-Takte je Abtastung
+#if (DCF_CYCLES % 1024) * 100 <= DCF_CYCLES && DCF_CYCLES / 1024 <= 255
 #define PRESCALER_0 1024
-#define TIMER_TICKS ((F_CPU / PRESCALER_0 * 10) / 1000)
+#define TIMER0_CS ((1 << CS02) | (1 << CS00))
+#elif (DCF_CYCLES % 256) * 100 <= DCF_CYCLES && DCF_CYCLES / 256 <= 255
+#define PRESCALER_0 256
+#define TIMER0_CS (1 << CS02)
+#elif (DCF_CYCLES % 64) * 100 <= DCF_CYCLES && DCF_CYCLES / 64 <= 255
+#define PRESCALER_0 64
+#define TIMER0_CS ((1 << CS01) | (1 << CS00))
+#elif !defined(DCF_SAMPLE_TIMER1)
+#error "DCF_SAMPLE_MS mit Timer0 nicht auf 1 % genau einstellbar, DCF_SAMPLE_TIMER1 verwenden"
+#endif
+#define TIMER_TICKS (DCF_CYCLES / PRESCALER_0)
 #define TIMER0_PRELOAD (256 - TIMER_TICKS)
 
-/* Initialisiert Timer0 zur DCF77-Decodierung (10‑ms-Periode) */
+/* Abtastzähler seit Impulsbeginn. Er läuft wie früher der 8-Bit-Zähler bei
+   10 ms alle 2,56 s über, damit ein fehlendes Signal weiterhin periodisch
+   als Fehler gemeldet wird; bei kürzeren Perioden reicht 8 Bit nicht mehr */
+#define DCF_WRAP (2560 / DCF_SAMPLE_MS)
+#if DCF_WRAP <= 256
+typedef uint8_t dcf_tick_t;
+#define dcf_threshold(i) pgm_read_byte(&dcf_thresholds[i])
+#else
+typedef uint16_t dcf_tick_t;
+#define dcf_threshold(i) pgm_read_word(&dcf_thresholds[i])
+#endif
+
+/* Rollen der Schwellen DCF_T0..DCF_T6 (aufsteigend) */
+enum
+{
+    TH_PULSE_MIN = 0,   // kürzester Impuls
+    TH_ZERO_MAX,        // Impulsende bis hier: Null, danach Eins
+    TH_ONE_MIN,         // kürzeste Eins
+    TH_ONE_MAX,         // längste Eins
+    TH_SECOND,          // Bit ausgeben, nächster Impuls erwartet
+    TH_MARK,            // kein Impuls: Minutenmarke
+    TH_MARK_MAX,        // weiterhin kein Impuls: Fehler
+    TH_COUNT
+};
+
+static const dcf_tick_t dcf_thresholds[TH_COUNT] PROGMEM =
+{
+    DCF_T0, DCF_T1, DCF_T2, DCF_T3, DCF_T4, DCF_T5, DCF_T6
+};
+
+static constexpr uint16_t dcf_thresholds_ms[TH_COUNT] =
+{
+    DCF_T0_MS, DCF_T1_MS, DCF_T2_MS, DCF_T3_MS, DCF_T4_MS, DCF_T5_MS, DCF_T6_MS
+};
+
+/* Schwellen ganzzahlig in Abtastschritten, streng aufsteigend, ab einem
+   Schritt und vor dem Überlauf des Abtastzählers */
+static constexpr bool dcf_thresholds_valid(void)
+{
+    for (uint8_t i = 0; i < TH_COUNT; i++)
+    {
+        if (dcf_thresholds_ms[i] % DCF_SAMPLE_MS != 0)
+            return false;
+        if (dcf_thresholds_ms[i] < (i ? dcf_thresholds_ms[i - 1] + DCF_SAMPLE_MS : DCF_SAMPLE_MS))
+            return false;
+    }
+    return dcf_thresholds_ms[TH_COUNT - 1] / DCF_SAMPLE_MS < DCF_WRAP;
+}
+static_assert(dcf_thresholds_valid(), "DCF_T0_MS..DCF_T6_MS passen nicht zu DCF_SAMPLE_MS");
+
+/* Zustandstabelle des Decoders (Zeta), beim Übersetzen aus den Rollen der
+   Schwellen erzeugt. Eingaben: TI = Schwelle erreicht, HI/LO = Signalpegel.
+   Zustände: 0 = Ruhe, dann Impuls bis TH_ZERO_MAX, Pause nach einer Null,
+   Impuls bis TH_ONE_MAX, Pause nach einer Eins, Warten auf den nächsten
+   Impuls bzw. die Minutenmarke */
+typedef enum
+{
+    TI = 0,
+    HI = 1,
+    LO = 2
+} Input;
+
+typedef struct
+{
+    uint8_t state;
+    char output;
+} ZetaValue;
+
+#define ZETA_PULSE0   1
+#define ZETA_GAP0     (ZETA_PULSE0 + TH_ZERO_MAX + 1)
+#define ZETA_PULSE1   (ZETA_GAP0 + TH_SECOND - TH_ZERO_MAX + 1)
+#define ZETA_GAP1     (ZETA_PULSE1 + TH_ONE_MAX - TH_ZERO_MAX)
+#define ZETA_WAIT     (ZETA_GAP1 + TH_SECOND - TH_ONE_MAX + 1)
+#define ZETA_STATES   (ZETA_WAIT + TH_MARK_MAX - TH_MARK + 1)
+
+typedef struct
+{
+    ZetaValue z[ZETA_STATES][3];
+} ZetaTable;
+
+/* Impuls läuft, nächste Schwelle k (k <= TH_ONE_MAX) */
+static constexpr uint8_t zeta_pulse(uint8_t k)
+{
+    return k <= TH_ZERO_MAX ? ZETA_PULSE0 + k : ZETA_PULSE1 + k - TH_ZERO_MAX - 1;
+}
+
+/* Impuls beendet (Null bzw. Eins), nächste Schwelle k (k <= TH_SECOND) */
+static constexpr uint8_t zeta_gap(uint8_t one, uint8_t k)
+{
+    return one ? ZETA_GAP1 + k - TH_ONE_MAX : ZETA_GAP0 + k - TH_ZERO_MAX;
+}
+
+static constexpr void zeta_set(ZetaTable &t, uint8_t state, Input input, uint8_t next, char output)
+{
+    t.z[state][input].state = next;
+    t.z[state][input].output = output;
+}
+
+static constexpr ZetaTable zeta_make(void)
+{
+    ZetaTable t = {};
+    uint8_t k = 0, s = 0, one = 0, first = 0;
+
+    // Ruhe: auf den Impulsbeginn warten
+    zeta_set(t, 0, TI, 0, 'e');
+    zeta_set(t, 0, HI, zeta_pulse(0), 'a');
+    zeta_set(t, 0, LO, 0, 'x');
+
+    // Impuls: endet er im Fenster vor TH_ZERO_MAX bzw. TH_ONE_MAX, folgt
+    // die Pause der Null bzw. Eins, sonst ist er zu kurz oder zu lang
+    for (k = 0; k <= TH_ONE_MAX; k++)
+    {
+        s = zeta_pulse(k);
+        zeta_set(t, s, HI, s, 'x');
+        if (k == TH_ZERO_MAX || k == TH_ONE_MAX)
+            zeta_set(t, s, LO, zeta_gap(k == TH_ONE_MAX, k), 'x');
+        else
+            zeta_set(t, s, LO, 0, 'e');
+        if (k == TH_ONE_MAX)
+            zeta_set(t, s, TI, 0, 'e');
+        else
+            zeta_set(t, s, TI, zeta_pulse(k + 1), 'x');
+    }
+
+    // Pause: kein Impuls bis TH_SECOND, dann ist das Bit gültig
+    for (one = 0; one < 2; one++)
+    {
+        first = one ? TH_ONE_MAX : TH_ZERO_MAX;
+        for (k = first; k <= TH_SECOND; k++)
+        {
+            s = zeta_gap(one, k);
+            zeta_set(t, s, HI, 0, 'e');
+            zeta_set(t, s, LO, s, 'x');
+            if (k == TH_SECOND)
+                zeta_set(t, s, TI, ZETA_WAIT, one ? '1' : '0');
+            else
+                zeta_set(t, s, TI, zeta_gap(one, k + 1), 'x');
+        }
+    }
+
+    // Warten: nächster Impuls, nach ausgelassener Sekunde Minutenmarke
+    zeta_set(t, ZETA_WAIT, TI, ZETA_WAIT + 1, 'x');
+    zeta_set(t, ZETA_WAIT, HI, zeta_pulse(0), 'a');
+    zeta_set(t, ZETA_WAIT, LO, ZETA_WAIT, 'x');
+    zeta_set(t, ZETA_WAIT + 1, TI, 0, 'e');
+    zeta_set(t, ZETA_WAIT + 1, HI, zeta_pulse(0), 'm');
+    zeta_set(t, ZETA_WAIT + 1, LO, ZETA_WAIT + 1, 'x');
+    return t;
+}
+
+/* Jeder Übergang hat eine Ausgabe und führt auf einen gültigen Zustand,
+   jeder Zustand außer der Ruhe wird erreicht */
+static constexpr bool zeta_valid(const ZetaTable &t)
+{
+    bool reached[ZETA_STATES] = {};
+    uint8_t s = 0, i = 0;
+
+    for (s = 0; s < ZETA_STATES; s++)
+        for (i = 0; i < 3; i++)
+        {
+            if (t.z[s][i].output == 0 || t.z[s][i].state >= ZETA_STATES)
+                return false;
+            if (t.z[s][i].state != s)
+                reached[t.z[s][i].state] = true;
+        }
+    for (s = 1; s < ZETA_STATES; s++)
+        if (!reached[s])
+            return false;
+    return true;
+}
+
+static_assert(zeta_valid(zeta_make()), "DCF77-Zustandstabelle fehlerhaft");
+static_assert(ZETA_STATES <= 255, "DCF77-Zustandstabelle zu groß");
+
+#if DCF_SAMPLE_MS == 10
+/* Bei 10 ms entspricht die erzeugte Tabelle genau der früher von Hand
+   aufgestellten (Zustände S0..S12); Abtaster im Vergleich: tools/dcfcheck.cpp */
+static constexpr ZetaValue zeta_10ms[13][3] =
+{
+    { { 0, 'e' }, { 1, 'a' }, { 0, 'x' } }, // S0
+    { { 2, 'x' }, { 1, 'x' }, { 0, 'e' } }, // S1
+    { { 7, 'x' }, { 2, 'x' }, { 3, 'x' } }, // S2
+    { { 4, 'x' }, { 0, 'e' }, { 3, 'x' } }, // S3
+    { { 5, 'x' }, { 0, 'e' }, { 4, 'x' } }, // S4
+    { { 6, 'x' }, { 0, 'e' }, { 5, 'x' } }, // S5
+    { {11, '0' }, { 0, 'e' }, { 6, 'x' } }, // S6
+    { { 8, 'x' }, { 7, 'x' }, { 0, 'e' } }, // S7
+    { { 0, 'e' }, { 8, 'x' }, { 9, 'x' } }, // S8
+    { {10, 'x' }, { 0, 'e' }, { 9, 'x' } }, // S9
+    { {11, '1' }, { 0, 'e' }, {10, 'x' } }, // S10
+    { {12, 'x' }, { 1, 'a' }, {11, 'x' } }, // S11
+    { { 0, 'e' }, { 1, 'm' }, {12, 'x' } }  // S12
+};
+
+static constexpr bool zeta_equal(const ZetaTable &t)
+{
+    for (uint8_t s = 0; s < 13; s++)
+        for (uint8_t i = 0; i < 3; i++)
+            if (t.z[s][i].state != zeta_10ms[s][i].state || t.z[s][i].output != zeta_10ms[s][i].output)
+                return false;
+    return true;
+}
+
+static_assert(ZETA_STATES == 13, "DCF77-Zustandstabelle bei 10 ms nicht mehr 13 Zustände");
+static_assert(zeta_equal(zeta_make()), "DCF77-Zustandstabelle bei 10 ms weicht von der bisherigen ab");
+#endif
+
+static const ZetaTable zeta PROGMEM = zeta_make();
+
+/* Klassenbreite des Impulshistogramms in Abtastschritten */
+#define DCF_HIST_TICKS  (DCF_HIST_MS / DCF_SAMPLE_MS)
+static_assert(DCF_HIST_MS % DCF_SAMPLE_MS == 0, "DCF_HIST_MS kein Vielfaches von DCF_SAMPLE_MS");
+static_assert((uint32_t)DCF_HIST_BINS * DCF_HIST_TICKS < DCF_WRAP, "Impulshistogramm zu breit");
+
+#ifdef DCF_SAMPLE_TIMER1
+#if ((F_CPU / 8) * DCF_SAMPLE_MS) % 1000 != 0
+#error "DCF_SAMPLE_TIMER1: DCF_SAMPLE_MS ist kein ganzzahliges Vielfaches des Timer1-Takts"
+#endif
+
+/* Startet die DCF77-Abtastung über Compare B des Timer1 (DCF_SAMPLE_MS).
+   Timer1 läuft dann frei (PWM_TIMER1_SHARED, pwm.h), bis weder PWM noch
+   Abtastung ihn brauchen */
 void init_TCNT0_DCF(void)
 {
-    TCCR0 = (1 << CS02) | (1 << CS00);   // Prescaler 1024
+    dcf_restart();
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        OCR1B = TCNT1 + DCF_T1_PERIOD;   // 16-Bit-Zugriff (TEMP-Register) schützen
+    }
+    TIFR = (1 << OCF1B);                 // nur das Compare-B-Flag löschen
+    TIMSK |= (1 << OCIE1B);
+    TCCR1B = 2;                          // Prescaler 8 (wie die PWM), läuft evtl. schon
+}
+#else
+/* Initialisiert Timer0 zur DCF77-Decodierung (DCF_SAMPLE_MS) */
+void init_TCNT0_DCF(void)
+{
+    dcf_restart();
+    TCCR0 = TIMER0_CS;                   // Prescaler PRESCALER_0
     TCNT0 = (uint8_t)TIMER0_PRELOAD;     // Preload setzen
     TIFR |= (1 << TOV0);                 // Overflow-Flag löschen
     TIMSK |= (1 << TOIE0);               // Timer0 Overflow-Interrupt aktivieren
 }
+#endif
 
-/* ISR für Timer0-Overflow – führt die DCF77-Decodierung aus */
-ISR(TIMER0_OVF_vect)
+/* Hält die DCF77-Abtastung an */
+void stop_TCNT0_DCF(void)
 {
-    typedef enum
+#ifdef DCF_SAMPLE_TIMER1
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)    // TIMSK teilt sich die Abtastung mit der PWM-ISR
     {
-        TI = 0,
-        HI = 1,
-        LO = 2
-    } Input;
+        TIMSK &= ~(1 << OCIE1B);
+#ifndef ISR_STATS
+        if (!(TIMSK & (1 << OCIE1A)))
+            TCCR1B = 0;                  // PWM ruht ebenfalls: Timer1 ganz aus
+#endif
+    }
+#else
+    TIMSK &= ~(1 << TOIE0);              // Timer0-Interrupt deaktivieren
+    TCCR0 = 0;                           // Timer0 stoppen
+#endif
+}
 
-    typedef struct
-    {
-        uint8_t state;
-        char output;
-    } ZetaValue;
+/* Zählt einen beendeten Impuls von width Abtastschritten im Histogramm */
+static inline void dcf_pulse(dcf_tick_t width)
+{
+    uint8_t bin = width / DCF_HIST_TICKS;
 
-    static const ZetaValue zeta[][3] PROGMEM =
-    {
-        { { 0, 'e' }, { 1, 'a' }, { 0, 'x' } }, // S0
-        { { 2, 'x' }, { 1, 'x' }, { 0, 'e' } }, // S1
-        { { 7, 'x' }, { 2, 'x' }, { 3, 'x' } }, // S2
-        { { 4, 'x' }, { 0, 'e' }, { 3, 'x' } }, // S3
-        { { 5, 'x' }, { 0, 'e' }, { 4, 'x' } }, // S4
-        { { 6, 'x' }, { 0, 'e' }, { 5, 'x' } }, // S5
-        { {11, '0' }, { 0, 'e' }, { 6, 'x' } }, // S6
-        { { 8, 'x' }, { 7, 'x' }, { 0, 'e' } }, // S7
-        { { 0, 'e' }, { 8, 'x' }, { 9, 'x' } }, // S8
-        { {10, 'x' }, { 0, 'e' }, { 9, 'x' } }, // S9
-        { {11, '1' }, { 0, 'e' }, {10, 'x' } }, // S10
-        { {12, 'x' }, { 1, 'a' }, {11, 'x' } }, // S11
-        { { 0, 'e' }, { 1, 'm' }, {12, 'x' } }  // S12
-    };
-
-    static uint8_t state = 0;   // aktueller Zustand S = 0 .. 12
-    static uint8_t tenMs = 0;   // Zähler in 10‑ms-Schritten (entspricht s/100)
+    if (bin >= DCF_HIST_BINS)
+        bin = DCF_HIST_BINS - 1;
+    if (dcf_quality.pulse_hist[bin] != 0xFFFF)
+        dcf_quality.pulse_hist[bin]++;
+}
+
+/* Ein Abtastschritt der DCF77-Decodierung (alle DCF_SAMPLE_MS aus der ISR).
+   Die Schwellen werden der Reihe nach erreicht, daher genügt ein Vergleich
+   mit der nächsten statt mit allen sieben */
+static inline void dcf_sample(void)
+{
+    static uint8_t state = 0;   // aktueller Zustand S = 0 .. ZETA_STATES-1
+    static dcf_tick_t ticks = 0;            // Abtastschritte seit Impulsbeginn
+    static dcf_tick_t next = DCF_T0;        // nächste Schwelle
+    static uint8_t nextNo = 0;              // deren Index
+    static dcf_tick_t width = 0;            // Abtastschritte des laufenden Impulses
     Input input;
     char output;
 
-    if ( tenMs == DCF_T0 || tenMs == DCF_T1 || tenMs == DCF_T2 ||
-            tenMs == DCF_T3 || tenMs == DCF_T4 || tenMs == DCF_T5 ||
-            tenMs == DCF_T6 )
+    if (ticks == next)
     {
         input = TI;
+        if (++nextNo == TH_COUNT)
+            nextNo = 0;     // nach dem Überlauf von ticks wieder ab DCF_T0
+        next = dcf_threshold(nextNo);
     }
     else if (DCF_SIGNAL)
     {
@@ -77,18 +370,186 @@ ISR(TIMER0_OVF_vect)
         input = LO;
     }
 
-    output = pgm_read_byte(&(zeta[state][(uint8_t)input].output));
-    state  = pgm_read_byte(&(zeta[state][(uint8_t)input].state));
+    /* Impulsbreite unabhängig vom Zustand messen; bei TI wird nicht
+       abgetastet, es gilt der bisherige Pegel */
+    if (input == LO)
+    {
+        if (width)
+            dcf_pulse(width);
+        width = 0;
+    }
+    else if ((input == HI || width) && width < DCF_HIST_BINS * DCF_HIST_TICKS)
+    {
+        width++;
+    }
+
+    output = pgm_read_byte(&(zeta.z[state][(uint8_t)input].output));
+    state  = pgm_read_byte(&(zeta.z[state][(uint8_t)input].state));
 
-    if (output == 'm')
-        tenMs = 0;
-    if (output == 'a')
-        tenMs = 0;
-    else if (output != 'x')
+    if (output == 'm' || output == 'a')
+    {
+        ticks = 0;
+        next = DCF_T0;
+        nextNo = 0;
+    }
+    if (output != 'a' && output != 'x')
+    {
         dcfEvent = (DCFEvent)output;
+        TRACE_EVENT(TRACE_DCF, output, ticks / (10 / DCF_SAMPLE_MS));
+    }
+
+#if DCF_WRAP == 256
+    ticks++;
+#else
+    if (++ticks == DCF_WRAP)
+        ticks = 0;
+#endif
+}
 
-    tenMs++;
+#ifdef DCF_SAMPLE_TIMER1
+/* ISR für Timer1 Compare B: der nächste Zeitpunkt folgt aus dem geplanten,
+   nicht aus dem tatsächlichen Eintritt, die Periode driftet daher nicht */
+ISR(TIMER1_COMPB_vect)
+{
+    ISR_STATS_ENTER();
+    ISR_STATS_LATENCY(ISR_STAT_TIMER0, OCR1B);
+    OCR1B += DCF_T1_PERIOD;
+    dcf_sample();
+    ISR_STATS_EXIT(ISR_STAT_TIMER0);
+}
+#else
+/* ISR für Timer0-Overflow – führt die DCF77-Decodierung aus */
+ISR(TIMER0_OVF_vect)
+{
+    ISR_STATS_ENTER();
+    dcf_sample();
     TCNT0 = (uint8_t)TIMER0_PRELOAD;
+    ISR_STATS_EXIT(ISR_STAT_TIMER0);
+}
+#endif
+
+/* Übernimmt die Uhrzeit nach Bit 35 ohne das Ende der Minute abzuwarten,
+   wenn Stunde und Minute (beide mit gültiger Parität) zur Erwartung passen.
+   Gesendet wird die Zeit ab der nächsten Minutenmarke, jetzt ist es also
+   eine Minute früher, Sekunde 35 kurz vor ihrem Ende */
+static void dcf_early(uint8_t hour, uint8_t minute)
+{
+    int16_t now, diff;
+
+    if (hour >= 24 || minute >= 60)
+        return;
+    now = hour * 60 + minute - 1;
+    if (now < 0)
+        now += 24 * 60;
+    diff = now - (int16_t)dcf_expect_minute;
+    if (diff > 12 * 60)
+        diff -= 24 * 60;
+    if (diff < -12 * 60)
+        diff += 24 * 60;
+    if (diff > dcf_expect_window || diff < -dcf_expect_window)
+        return;
+
+    ATOMIC_BLOCK(ATOMIC_FORCEON)
+    {
+        dcf_hours = now / 60;
+        dcf_minutes = now % 60;
+        dcf_second = 35;
+        dcf_fraction = DCF_BIT_FRACTION;
+        dcf_expect_window = 0;
+        set_dcf_sync(1);
+    }
+}
+
+void dcf_expect(uint8_t hours, uint8_t minutes, uint8_t window)
+{
+    dcf_expect_minute = hours * 60 + minutes;
+    dcf_expect_window = window;
+    dcf_restart();
+}
+
+/* Zählt ein Ereignis des Decoders für die Empfangsqualität. Die Stelle der
+   Minutenmarke wird unabhängig von Paritäts- und Plausibilitätsprüfungen
+   bewertet: nach 59 Bits muss sie kommen, sonst ist sie falsch erkannt */
+static void dcf_quality_event(DCFEvent event)
+{
+    DcfQuality *q = &dcf_quality;
+
+    switch (event)
+    {
+    case DCF_0:
+    case DCF_1:
+        q->bits++;
+        q->window_valid++;
+        if (dcf_quality_pos == 59)
+        {
+            q->marks_bad++;             // ausgelassene Sekunde nicht erkannt
+            dcf_quality_pos = 0xFF;
+        }
+        else if (dcf_quality_pos != 0xFF)
+        {
+            dcf_quality_pos++;
+        }
+        break;
+    case DCF_MARK:
+        q->window_valid++;
+        if (dcf_quality_pos == 59)
+            q->marks_ok++;
+        else if (dcf_quality_pos != 0xFF)
+            q->marks_bad++;
+        dcf_quality_pos = 0;
+        break;
+    case DCF_FAIL:
+        if (q->fails != 0xFFFF)
+            q->fails++;
+        dcf_quality_pos = 0xFF;
+        break;
+    default:
+        break;
+    }
+}
+
+#ifdef TRACE
+/* Sicherheit der Erkennung der ausgelassenen Sekunde [%]: Anteil der
+   Minutenmarken an der erwarteten Stelle, 0xFF ohne Marke */
+static uint8_t mark_confidence(const DcfQuality *q)
+{
+    uint16_t n = q->marks_ok + q->marks_bad;
+
+    if (n == 0)
+        return 0xFF;
+    return (uint32_t)q->marks_ok * 100 / n;
+}
+#endif
+
+void dcf_quality_reset(void)
+{
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        memset(&dcf_quality, 0, sizeof(dcf_quality));
+    }
+    dcf_quality_pos = 0xFF;
+}
+
+uint8_t dcf_quality_second(void)
+{
+    DcfQuality *q = &dcf_quality;
+
+    if (q->seconds != 0xFFFF)
+        q->seconds++;
+    if (++q->window < DCF_QUALITY_SECONDS)
+        return 0;
+
+    q->quality = q->window_valid >= DCF_QUALITY_SECONDS ? 100 : q->window_valid * 100 / DCF_QUALITY_SECONDS;
+    TRACE_EVENT(TRACE_QUALITY, q->quality, mark_confidence(q));
+    if (q->windows != 0xFF)
+        q->windows++;
+    if (q->windows > 1 && q->quality < DCF_QUALITY_MIN)
+        q->bad_windows++;
+    else
+        q->bad_windows = 0;
+    q->window = 0;
+    q->window_valid = 0;
+    return q->bad_windows >= DCF_ABORT_WINDOWS;
 }
 
 /* Führt die DCF77-Decodierung aus – soll in der Hauptschleife aufgerufen werden */
@@ -98,21 +559,30 @@ void dcf_process(void)
     static const uint8_t BCD[] = { 1, 2, 4, 8, 10, 20, 40, 80 };
     static uint8_t parity = 0;
     static uint8_t dlsTime = 0;
+    static uint8_t announce = 0;    // Bit 16: Zeitumstellung angekündigt, keine vorzeitige Übernahme
     static uint8_t bitNo = 0;   // Bitnummer (0 bis 58 oder FAIL)
     static uint8_t minute = 0;
     static uint8_t hour = 0;
     static uint8_t day = 1;
     static uint8_t month = 1;
     static uint8_t year = 0;
+    static uint8_t framed = 0;  // Bitnummer zählt ab einer Minutenmarke
 
     uint8_t dcfBit = 0;
     DCFEvent event;
 
+    if (dcf_restarted)
+    {
+        dcf_restarted = 0;
+        bitNo = FAIL;
+        framed = 0;
+    }
     ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
     {
         event = dcfEvent;
         dcfEvent = DCF_NONE;
     }
+    dcf_quality_event(event);
 
     if (event == DCF_MARK && bitNo == 59)
     {
@@ -123,6 +593,9 @@ void dcf_process(void)
                der RTC-Zähler (Timer2) zurückgesetzt */
             dcf_hours = hour;
             dcf_minutes = minute;
+            dcf_second = 0;
+            dcf_fraction = 0;
+            dcf_expect_window = 0;
             set_dcf_sync(1);
         }
         // (Weitere Daten wie Tag, Monat, Jahr könnten hier verarbeitet werden)
@@ -138,6 +611,10 @@ void dcf_process(void)
     case DCF_1:
         dcfBit = 1;
         break;
+    case DCF_FAIL:
+        STATS_INC(dcf_fail);
+        bitNo = FAIL;
+        break;
     default:
         bitNo = FAIL;
     }
@@ -160,7 +637,9 @@ void dcf_process(void)
     case 13:
     case 14:
     case 15:
+        break;
     case 16:
+        announce = dcfBit;      // Zeitumstellung zum Ende dieser Stunde angekündigt
         break;
     case 17:
         dlsTime = dcfBit;
@@ -201,6 +680,7 @@ void dcf_process(void)
         break;
     case 35:
         if (parity) bitNo = FAIL;
+        else if (framed && dcf_expect_window && !announce) dcf_early(hour, minute);
         break;
     case 36:
         parity = dcfBit;
@@ -244,6 +724,8 @@ void dcf_process(void)
     default:
         bitNo = FAIL;
     }
+    if (bitNo == FAIL)
+        framed = (event == DCF_MARK);
     bitNo++;
 }
 
@@ -262,8 +744,17 @@ void dcf_getTime(uint8_t *hours, uint8_t *minutes)
     }
 }
 
+/* Liefert Sekunde und Sekundenanteil zum Zeitpunkt der Übernahme */
+void dcf_getPhase(uint8_t *second, uint8_t *fraction)
+{
+    *second = dcf_second;
+    *fraction = dcf_fraction;
+}
+
 void set_dcf_sync(uint8_t value)
 {
+    if (value != dcf_sync)
+        TRACE_EVENT(TRACE_SYNC, value, dcf_sync);
     dcf_sync = value;
 }
 
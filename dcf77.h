@@ -7,14 +7,37 @@
 #include <avr/pgmspace.h>
 #include <stdint.h>
 
-/* DCF77 Timing-Konstanten (in 10‑ms-Schritten) */
-#define DCF_T0    6
-#define DCF_T1   15
-#define DCF_T2   17
-#define DCF_T3   25
-#define DCF_T4   95
-#define DCF_T5  120
-#define DCF_T6  220
+/* Abtastperiode in ms (Teiler von 10). Kürzere Perioden verbessern die
+   Flankenauflösung; Zustandstabelle und Schwellen werden daraus beim
+   Übersetzen erzeugt (dcf77.cpp) */
+#ifndef DCF_SAMPLE_MS
+#define DCF_SAMPLE_MS   10
+#endif
+
+/* DCF77 Zeitschwellen in ms ab Impulsbeginn */
+#define DCF_T0_MS     60    // kürzester Impuls
+#define DCF_T1_MS    150    // längste Null
+#define DCF_T2_MS    170    // kürzeste Eins
+#define DCF_T3_MS    250    // längste Eins
+#define DCF_T4_MS    950    // Bit gültig, nächster Impuls erwartet
+#define DCF_T5_MS   1200    // ausgelassene Sekunde 59: Minutenmarke
+#define DCF_T6_MS   2200    // kein Impuls mehr: Fehler
+
+/* DCF77 Timing-Konstanten (in Abtastschritten) */
+#define DCF_T0   (DCF_T0_MS / DCF_SAMPLE_MS)
+#define DCF_T1   (DCF_T1_MS / DCF_SAMPLE_MS)
+#define DCF_T2   (DCF_T2_MS / DCF_SAMPLE_MS)
+#define DCF_T3   (DCF_T3_MS / DCF_SAMPLE_MS)
+#define DCF_T4   (DCF_T4_MS / DCF_SAMPLE_MS)
+#define DCF_T5   (DCF_T5_MS / DCF_SAMPLE_MS)
+#define DCF_T6   (DCF_T6_MS / DCF_SAMPLE_MS)
+
+/* Abtastung alle DCF_SAMPLE_MS: standardmäßig Timer0 (Overflow, Nachladen
+   in der ISR: bei 10 ms 39 Takte à 256 µs = 9,984 ms, dazu bis zu einem
+   Takt Versatz je Nachladen). Mit DCF_SAMPLE_TIMER1 übernimmt Compare B
+   des Timer1 (OCR1B += DCF_T1_PERIOD, exakt ohne Drift); Timer0 bleibt
+   dann frei und abgeschaltet. */
+#define DCF_T1_PERIOD   ((F_CPU / 8) * DCF_SAMPLE_MS / 1000)   // Abtastperiode in Timer1-Takten (Prescaler 8)
 
 /* DCF77 Hardware-Definitionen */
 #define DCF_DDR         DDRD
@@ -22,6 +45,40 @@
 #define DCF_PWR         (1 << 4)
 #define DCF_SIGNAL      (PIND & (1 << 0))
 
+/* Empfangsqualität: Impulsbreiten in DCF_HIST_BINS Klassen zu DCF_HIST_MS
+   (die letzte nimmt alle längeren auf), Bewertung je Fenster von
+   DCF_QUALITY_SECONDS Sekunden Empfängerbetrieb nach dem Anteil gültiger
+   Sekunden (Bits und Minutenmarken). Bleibt er nach dem ersten Fenster
+   (Einschwingen des Empfängers) DCF_ABORT_WINDOWS Fenster in Folge unter
+   DCF_QUALITY_MIN, gilt der Versuch als aussichtslos: das Hauptprogramm
+   schaltet den Empfänger ab und versucht es nach DCF_RETRY_MINUTES erneut,
+   nach jedem weiteren Abbruch doppelt so spät, höchstens DCF_RETRY_MAX */
+#define DCF_HIST_BINS        8
+#define DCF_HIST_MS         40
+#define DCF_QUALITY_SECONDS 60
+#define DCF_QUALITY_MIN     50          // [%]
+#define DCF_ABORT_WINDOWS    3
+#define DCF_RETRY_MINUTES   15
+#define DCF_RETRY_MAX      240
+
+typedef struct
+{
+    uint16_t pulse_hist[DCF_HIST_BINS]; // Impulsbreiten (von der ISR gezählt)
+    uint16_t seconds;                   // Empfängerbetrieb dieses Versuchs [s]
+    uint16_t bits;                      // gültige Bits
+    uint16_t fails;                     // DCF_FAIL-Ereignisse
+    uint16_t marks_ok;                  // Minutenmarke nach Bit 58
+    uint16_t marks_bad;                 // Marke an falscher Stelle oder Impuls statt Marke
+    uint8_t  window;                    // Sekunden im laufenden Fenster
+    uint8_t  window_valid;              // davon gültige
+    uint8_t  windows;                   // abgeschlossene Fenster
+    uint8_t  quality;                   // gültige Sekunden im letzten Fenster [%]
+    uint8_t  bad_windows;               // Fenster in Folge unter DCF_QUALITY_MIN
+} DcfQuality;
+
+/* Messwerte des laufenden bzw. letzten Versuchs (nur lesen) */
+extern DcfQuality dcf_quality;
+
 /* DCF77 Ereignistyp */
 typedef enum
 {
@@ -33,15 +90,36 @@ typedef enum
 } DCFEvent;
 
 /* Öffentliche Funktionen des DCF77-Moduls */
-// Initialisiert Timer0 für eine 10‑ms-Periode zur DCF77‑Decodierung
+// Startet die Abtastung zur DCF77‑Decodierung (Timer0 bzw. Timer1 Compare B);
+// der Decoder verwirft Bitnummer und anstehendes Ereignis (vorzeitige Übernahme erst wieder nach einer Minutenmarke)
 void init_TCNT0_DCF(void);
 
+// Hält die Abtastung an
+void stop_TCNT0_DCF(void);
+
 // Sollte in der Hauptschleife periodisch aufgerufen werden, um den DCF77-Datenstrom auszuwerten
 void dcf_process(void);
 
+// Erlaubt die Übernahme schon nach Bit 35 (Stunde und Minute mit Parität,
+// ohne Datum), wenn die empfangene Uhrzeit höchstens window Minuten von
+// hours:minutes abweicht; gilt für eine Synchronisation, window 0 = aus.
+// Setzt den Decoder wie init_TCNT0_DCF zurück
+void dcf_expect(uint8_t hours, uint8_t minutes, uint8_t window);
+
+// Sekunde und Sekundenanteil (1/256 s) der übernommenen Uhrzeit:
+// 0/0 an der Minutenmarke, Sekunde 35 kurz vor ihrem Ende bei vorzeitiger Übernahme
+void dcf_getPhase(uint8_t *second, uint8_t *fraction);
+
 void set_dcf_sync(uint8_t value);
 uint8_t get_dcf_sync(void);
 
+// Setzt die Empfangsqualität zurück (beim Einschalten des Empfängers)
+void dcf_quality_reset(void);
+
+// Jede Sekunde bei eingeschaltetem Empfänger aufrufen: schließt die Fenster
+// ab, liefert 1, wenn der Versuch aussichtslos ist
+uint8_t dcf_quality_second(void);
+
 // Liefert bei erfolgreicher Synchronisation die dekodierten Stunden und Minuten
 void dcf_getTime(uint8_t *hours, uint8_t *minutes);
 
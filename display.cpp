@@ -0,0 +1,145 @@
+#include "display.h"
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/pgmspace.h>
+#include <util/atomic.h>
+#include "pwm.h"
+#include "isrstat.h"
+
+/* Definition der Ausgänge für die Anzeige (z.B. Stunden und Minuten) */
+#define H_PORT  PORTC
+#define H_DDR   DDRC
+#define M_PORT  PORTB
+#define M_DDR   DDRB
+
+static uint8_t display_h, display_m;            // angezeigte Uhrzeit
+static uint8_t display_lvl = DISPLAY_FULL;      // aktuelle Helligkeitsstufe
+
+/* Schreibt das Bitmuster auf die Ports (PWM-Ausgänge nicht überschreiben, die ISR ändert sie) */
+static inline void display_out(uint8_t hours, uint8_t minutes)
+{
+    H_PORT = (H_PORT & PWM_MASK_C) | (hours & ~PWM_MASK_C);
+    M_PORT = (M_PORT & PWM_MASK_B) | (minutes & ~PWM_MASK_B);
+}
+
+#ifdef DISPLAY_BCM
+
+#ifndef DCF_SAMPLE_TIMER1
+#error "DISPLAY_BCM benötigt Timer0, die DCF-Abtastung mit -DDCF_SAMPLE_TIMER1 auf Timer1 legen"
+#endif
+
+/* Timer0 (nur Überlauf) mit Vorteiler 64; ein Abschnitt k dauert
+   DISPLAY_UNIT << k Ticks, der längste muss in 8 Bit passen */
+#define DISPLAY_PRESCALER   64
+#define DISPLAY_CS          ((1 << CS01) | (1 << CS00))
+#define DISPLAY_UNIT        ((F_CPU / DISPLAY_PRESCALER) / (DISPLAY_HZ * DISPLAY_FULL))
+
+#if DISPLAY_UNIT < 8 || (DISPLAY_UNIT << (DISPLAY_BITS - 1)) > 255
+#error "DISPLAY_HZ/DISPLAY_BITS passen nicht zu Timer0 (Vorteiler 64)"
+#endif
+
+/* Helligkeit je Stunde (0..23): tagsüber voll, nachts gedimmt */
+static const uint8_t display_day[24] PROGMEM =
+{
+     1,  1,  1,  1,  1,  2,     // 0-5 Uhr
+     4,  8, 15, 15, 15, 15,     // 6-11 Uhr
+    15, 15, 15, 15, 15, 15,     // 12-17 Uhr
+    15,  8,  6,  4,  2,  1      // 18-23 Uhr
+};
+
+/* Bitmuster je Abschnitt (Abschnitt k leer, wenn Bit k der Stufe fehlt) */
+static uint8_t frame_h[DISPLAY_BITS];
+static uint8_t frame_m[DISPLAY_BITS];
+static uint8_t display_bit;                     // laufender Abschnitt
+
+/* Nächster Abschnitt: Timer0 um dessen Dauer vorstellen und Muster ausgeben */
+ISR(TIMER0_OVF_vect)
+{
+    ISR_STATS_ENTER();
+    uint8_t k = display_bit + 1;
+    if (k >= DISPLAY_BITS)
+        k = 0;
+    display_bit = k;
+    /* relativ zum Überlauf, die Eintrittslatenz wird so ausgeglichen */
+    TCNT0 += (uint8_t)-(uint8_t)(DISPLAY_UNIT << k);
+    display_out(frame_h[k], frame_m[k]);
+    ISR_STATS_EXIT(ISR_STAT_DISPLAY);
+}
+
+/* Abschnittsmuster neu berechnen; bei Stufe 0 und voll steht Timer0 */
+static void display_update(void)
+{
+    uint8_t k;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        for (k = 0; k < DISPLAY_BITS; k++)
+        {
+            uint8_t on = display_lvl & (1 << k);
+            frame_h[k] = on ? display_h : 0;
+            frame_m[k] = on ? display_m : 0;
+        }
+        if (display_lvl == 0 || display_lvl == DISPLAY_FULL)
+        {
+            TIMSK &= ~(1 << TOIE0);
+            TCCR0 = 0;
+            display_out(frame_h[0], frame_m[0]);
+        }
+        else if (!(TIMSK & (1 << TOIE0)))
+        {
+            display_bit = DISPLAY_BITS - 1;     // erster Überlauf startet Abschnitt 0
+            TCNT0 = 0xFF;
+            TIFR = (1 << TOV0);
+            TCCR0 = DISPLAY_CS;
+            TIMSK |= (1 << TOIE0);
+        }
+    }
+}
+
+void display_hour(uint8_t hours)
+{
+    if (hours < 24)
+        display_level(pgm_read_byte(&display_day[hours]));
+}
+
+#else
+
+static void display_update(void)
+{
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        if (display_lvl)
+            display_out(display_h, display_m);
+        else
+            display_out(0, 0);
+    }
+}
+
+void display_hour(uint8_t hours)
+{
+    (void)hours;        // ohne DISPLAY_BCM immer volle Helligkeit
+}
+
+#endif // DISPLAY_BCM
+
+void display_init(void)
+{
+    H_DDR = 0xFF;
+    M_DDR = 0xFF;
+    display_update();
+}
+
+void display_show(uint8_t hours, uint8_t minutes)
+{
+    display_h = hours;
+    display_m = minutes;
+    display_update();
+}
+
+void display_level(uint8_t level)
+{
+    if (level > DISPLAY_FULL)
+        level = DISPLAY_FULL;
+    display_lvl = level;
+    display_update();
+}
@@ -0,0 +1,36 @@
+#ifndef DISPLAY_H
+#define DISPLAY_H
+
+#include <stdint.h>
+
+/* Binäranzeige der Uhrzeit: Stunden auf PORTC, Minuten auf PORTB (die Bits
+   der PWM-Kanäle bleiben unberührt).
+
+   Mit -DDISPLAY_BCM ist die Helligkeit in DISPLAY_LEVELS Stufen einstellbar
+   (Binary Code Modulation auf Timer0, setzt DCF_SAMPLE_TIMER1 voraus, da
+   Timer0 sonst die DCF-Abtastung treibt): ein Zyklus besteht aus
+   DISPLAY_BITS Abschnitten, Abschnitt k dauert 2^k Einheiten und zeigt die
+   Uhrzeit nur, wenn Bit k der Stufe gesetzt ist. Das kostet einen
+   Interrupt je Abschnitt, bei 4 Bit und 200 Hz also 800/s, eine Soft-PWM
+   mit 15 Schritten bräuchte 3000/s. Bei Stufe 0 und voller Helligkeit
+   steht Timer0. Die Stufe folgt der Stunde (display_hour(), nachts
+   gedimmt). Ohne DISPLAY_BCM leuchtet die Anzeige immer voll. */
+#define DISPLAY_BITS        4
+#define DISPLAY_LEVELS      (1 << DISPLAY_BITS)     // Stufen 0 .. DISPLAY_LEVELS-1
+#define DISPLAY_FULL        (DISPLAY_LEVELS - 1)
+#define DISPLAY_HZ          200                     // Wiederholrate [Hz]
+#define DISPLAY_LED_MA      10                      // Strom einer LED bei voller Helligkeit (nur für bench.h)
+
+/* Ausgänge der Anzeige konfigurieren, volle Helligkeit */
+void display_init(void);
+
+/* Zeigt Stunden und Minuten an */
+void display_show(uint8_t hours, uint8_t minutes);
+
+/* Setzt die Helligkeit (0 = aus .. DISPLAY_FULL); ohne DISPLAY_BCM nur aus oder voll */
+void display_level(uint8_t level);
+
+/* Helligkeit für die Stunde hours laut Tagesverlauf (display.cpp) */
+void display_hour(uint8_t hours);
+
+#endif // DISPLAY_H
@@ -0,0 +1,145 @@
+#include "glyph.h"
+#include "kinematics.h"
+#include <avr/pgmspace.h>
+
+#define M(x, y)                 { GLYPH_MOVE,   { x, y } }
+#define L(x, y)                 { STROKE_LINE,  { x, y } }
+#define A(cx, cy, r, s, b)      { STROKE_ARC,   { cx, cy, r, (int8_t)(s), b } }
+#define C(a, b, c, d, e, f)     { STROKE_CUBIC, { a, b, c, d, e, f } }
+#define END                     { GLYPH_END,    { 0 } }
+
+static const GlyphStroke glyphs[] PROGMEM =
+{
+    /* 0: Ellipse (Mitte 14/20, Halbachsen 10/20) */
+    M(14, 0), C(20, 0, 24, 9, 24, 20), C(24, 31, 20, 40, 14, 40),
+    C(8, 40, 4, 31, 4, 20), C(4, 9, 8, 0, 14, 0), END,
+    /* 1 */
+    M(6, 30), L(20, 40), L(20, 0), END,
+    /* 2 */
+    M(4, 30), A(16, 28, 12, 122, -39), L(2, 0), L(24, 0), END,
+    /* 3 */
+    M(0, 31), A(10, 30, 10, 122, -51), L(10, 20), A(10, 10, 10, 64, -47), END,
+    /* 4 */
+    M(20, 0), L(20, 40), L(4, 12), L(24, 12), END,
+    /* 5 */
+    M(0, 5), A(10, 12, 12, 154, 46), L(10, 40), L(24, 40), END,
+    /* 6 */
+    M(9, 23), A(14, 12, 12, 81, -65), L(22, 40), END,
+    /* 7 */
+    M(4, 40), L(24, 40), L(4, 0), END,
+    /* 8 */
+    M(10, 20), A(10, 30, 10, 191, -64), A(10, 10, 10, 65, 68), END,
+    /* 9 */
+    M(7, 22), A(14, 30, 10, 163, -46), L(10, 0), END,
+    /* : */
+    M(10, 30), L(10, 31), M(10, 10), L(10, 11), END
+};
+
+/* Startindex je Glyphe in glyphs[] */
+static const uint8_t glyph_start[GLYPH_COUNT] PROGMEM =
+{
+    0, 6, 10, 15, 20, 25, 30, 34, 38, 42, 46
+};
+
+uint8_t glyph_read(uint8_t glyph, uint8_t index, GlyphStroke *out)
+{
+    memcpy_P(out, &glyphs[pgm_read_byte(&glyph_start[glyph]) + index], sizeof(GlyphStroke));
+    return out->type != GLYPH_END;
+}
+
+int16_t glyph_scale(int16_t origin, int8_t v)
+{
+    return origin + (int16_t)(((int16_t)v * GLYPH_SCALE + 8) >> 4);
+}
+
+/* Bogen: Start [1/256 Umdrehung] und Bogen [1/64 Umdrehung] in 1/16 Grad */
+static int16_t arc_start(const GlyphStroke *g)
+{
+    return (int16_t)((uint16_t)(uint8_t)g->v[3] * 45 / 2);
+}
+
+static int16_t arc_sweep(const GlyphStroke *g)
+{
+    return (int16_t)g->v[4] * 90;
+}
+
+void glyph_end(const GlyphStroke *g, int16_t ox, int16_t oy, int16_t *x, int16_t *y)
+{
+    int16_t r, a;
+
+    switch (g->type)
+    {
+    case STROKE_ARC:
+        r = glyph_scale(0, g->v[2]);
+        a = arc_start(g) + arc_sweep(g);
+        *x = glyph_scale(ox, g->v[0]) + (int16_t)(((int32_t)r * kin_cos(a) + 8192) >> 14);
+        *y = glyph_scale(oy, g->v[1]) + (int16_t)(((int32_t)r * kin_sin(a) + 8192) >> 14);
+        break;
+    case STROKE_QUAD:
+        *x = glyph_scale(ox, g->v[2]);
+        *y = glyph_scale(oy, g->v[3]);
+        break;
+    case STROKE_CUBIC:
+        *x = glyph_scale(ox, g->v[4]);
+        *y = glyph_scale(oy, g->v[5]);
+        break;
+    default:                            // GLYPH_MOVE, STROKE_LINE
+        *x = glyph_scale(ox, g->v[0]);
+        *y = glyph_scale(oy, g->v[1]);
+    }
+}
+
+void glyph_stroke(const GlyphStroke *g, int16_t ox, int16_t oy, int16_t x, int16_t y, Stroke *out)
+{
+    uint8_t i;
+
+    out->type = g->type;
+    if (g->type == STROKE_ARC)
+    {
+        out->p[0] = glyph_scale(ox, g->v[0]);
+        out->p[1] = glyph_scale(oy, g->v[1]);
+        out->p[2] = glyph_scale(0, g->v[2]);
+        out->p[3] = arc_start(g);
+        out->p[4] = arc_sweep(g);
+        return;
+    }
+
+    /* Linie/Bézier: Startpunkt ist die aktuelle Stiftposition */
+    out->p[0] = x;
+    out->p[1] = y;
+    for (i = 0; i < 6; i += 2)
+    {
+        out->p[i + 2] = glyph_scale(ox, g->v[i]);
+        out->p[i + 3] = glyph_scale(oy, g->v[i + 1]);
+    }
+}
+
+void glyph_stroke_reverse(const GlyphStroke *g, int16_t ox, int16_t oy, int16_t x, int16_t y,
+                          int16_t tx, int16_t ty, Stroke *out)
+{
+    glyph_stroke(g, ox, oy, x, y, out);
+    switch (g->type)
+    {
+    case STROKE_ARC:
+        out->p[3] += out->p[4];
+        out->p[4] = -out->p[4];
+        return;
+    case STROKE_LINE:
+        out->p[2] = tx;
+        out->p[3] = ty;
+        break;
+    case STROKE_QUAD:
+        out->p[4] = tx;
+        out->p[5] = ty;
+        break;
+    case STROKE_CUBIC:
+        /* Kontrollpunkte tauschen */
+        out->p[2] = glyph_scale(ox, g->v[2]);
+        out->p[3] = glyph_scale(oy, g->v[3]);
+        out->p[4] = glyph_scale(ox, g->v[0]);
+        out->p[5] = glyph_scale(oy, g->v[1]);
+        out->p[6] = tx;
+        out->p[7] = ty;
+        break;
+    }
+}
@@ -0,0 +1,51 @@
+#ifndef GLYPH_H
+#define GLYPH_H
+
+#include <stdint.h>
+#include "stroke.h"
+
+/* Ziffernformen der Plotclock (aus dem Arduino-Sketch übertragen).
+   Eine Glyphe ist eine Folge von Elementen in Zellkoordinaten (Einheit
+   0,5 mm vor Skalierung, Ursprung links unten). Zeichenelemente beginnen
+   am Endpunkt des vorherigen Elements; GLYPH_MOVE hebt den Stift und fährt
+   zum angegebenen Punkt. */
+#define GLYPH_MOVE      4               // v: x, y
+/* Zeichenelemente (Typ = StrokeType):
+   STROKE_LINE  v: x, y (Ziel)
+   STROKE_ARC   v: cx, cy, r, Start [1/256 Umdrehung], Bogen [1/64 Umdrehung]
+   STROKE_QUAD  v: x1, y1, x2, y2
+   STROKE_CUBIC v: x1, y1, x2, y2, x3, y3 */
+#define GLYPH_END       0xFF
+
+#define GLYPH_COLON     10              // Doppelpunkt zwischen Stunden und Minuten
+#define GLYPH_COUNT     11
+
+/* Skalierung Zelleinheit -> 1/16 mm im Format Q4: 0,5 mm * 0,9 = 7,2 (~115/16) */
+#define GLYPH_SCALE     115
+
+typedef struct
+{
+    uint8_t type;                       // GLYPH_MOVE, StrokeType oder GLYPH_END
+    int8_t  v[6];
+} GlyphStroke;
+
+/* Liest Element index der Glyphe glyph; Rückgabe 0 am Ende der Glyphe */
+uint8_t glyph_read(uint8_t glyph, uint8_t index, GlyphStroke *out);
+
+/* Zellpunkt (vx, vy) -> absolute Position in 1/16 mm bei Zellursprung (ox, oy) */
+int16_t glyph_scale(int16_t origin, int8_t v);
+
+/* Wandelt ein Zeichenelement in ein absolutes Strichelement, das an der
+   aktuellen Stiftposition (x, y) beginnt */
+void glyph_stroke(const GlyphStroke *g, int16_t ox, int16_t oy, int16_t x, int16_t y, Stroke *out);
+
+/* Endpunkt eines Elements (absolut, 1/16 mm) */
+void glyph_end(const GlyphStroke *g, int16_t ox, int16_t oy, int16_t *x, int16_t *y);
+
+/* Wie glyph_stroke(), aber rückwärts: das Element wird von der aktuellen
+   Stiftposition (x, y) zu seinem Anfangspunkt (tx, ty) gezeichnet, der dem
+   Endpunkt des vorherigen Elements entspricht */
+void glyph_stroke_reverse(const GlyphStroke *g, int16_t ox, int16_t oy, int16_t x, int16_t y,
+                          int16_t tx, int16_t ty, Stroke *out);
+
+#endif // GLYPH_H
@@ -0,0 +1,74 @@
+#include "isrstat.h"
+
+#ifdef ISR_STATS
+
+#include <string.h>
+#include <util/atomic.h>
+
+IsrStat isr_stat_time[ISR_STAT_COUNT];
+IsrStat isr_stat_latency[ISR_STAT_COUNT];
+
+void isr_stats_init(void)
+{
+    isr_stats_reset();
+    if (!(TCCR1B & 7))
+        TCCR1B = 2;                     // Prescaler 8 wie die PWM
+}
+
+void isr_stats_record(IsrStat *s, uint16_t ticks)
+{
+    uint8_t b = 0;
+    uint16_t v = ticks;
+
+    while (v >= 2 && b < ISR_STAT_BUCKETS - 1)
+    {
+        v >>= 1;
+        b++;
+    }
+    if (s->hist[b] != 0xFFFF)
+        s->hist[b]++;
+    if (s->count == 0 || ticks < s->min)
+        s->min = ticks;
+    if (ticks > s->max)
+        s->max = ticks;
+    if (s->count != 0xFFFF)
+        s->count++;
+}
+
+void isr_stats_reset(void)
+{
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        memset(isr_stat_time, 0, sizeof(isr_stat_time));
+        memset(isr_stat_latency, 0, sizeof(isr_stat_latency));
+    }
+}
+
+static_assert(ISR_STAT_DUMP_BYTES <= 255, "Position der Ausgabe passt nicht in ein Byte");
+
+uint8_t isr_stats_dump(uint8_t pos, uint8_t n, void (*put)(uint8_t pos, uint8_t byte))
+{
+    static IsrStat copy[2];             // Werte des gerade ausgegebenen Interrupts
+    const uint8_t *p = (const uint8_t *)copy;
+    uint8_t id, i;
+
+    for (; n && pos < ISR_STAT_DUMP_BYTES; n--, pos++)
+    {
+        id = pos / ISR_STAT_DUMP_ENTRY;
+        i = pos % ISR_STAT_DUMP_ENTRY;
+        if (i == 0)
+        {
+            ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+            {
+                copy[0] = isr_stat_time[id];
+                copy[1] = isr_stat_latency[id];
+            }
+            put(pos, id);
+        }
+        else
+            put(pos, p[i - 1]);
+    }
+    return pos;
+}
+
+#endif // ISR_STATS
@@ -0,0 +1,73 @@
+#ifndef ISRSTAT_H
+#define ISRSTAT_H
+
+#include <avr/io.h>
+#include <stdint.h>
+
+/* Laufzeit- und Latenzstatistik der Interrupts (nur mit -DISR_STATS).
+   Zeitbasis ist der freilaufende Timer1 (Prescaler 8, ein Tick = 8 Takte);
+   mit ISR_STATS läuft Timer1 auch ohne PWM weiter, nur der Compare-
+   Interrupt wird dann gesperrt.
+
+   Gemessen wird vom ersten Befehl nach dem Prolog bis vor den Epilog; der
+   Prolog (Register sichern, ca. 20..40 Takte) ist nicht enthalten. Die
+   Latenz (Compare-Zeitpunkt bis Eintritt) ist nur für Timer1 Compare A
+   exakt bestimmbar und wird nur dort erfasst.
+
+   Kosten je ISR: ein Aufruf von isr_stats_record() (ca. 80 Takte,
+   höchstens 7 Schleifendurchläufe für den Histogrammeintrag). */
+#define ISR_STAT_TIMER0     0           // DCF-Abtastung (TIMER0_OVF_vect bzw. TIMER1_COMPB_vect)
+#define ISR_STAT_TIMER1A    1           // TIMER1_COMPA_vect (Soft-PWM)
+#define ISR_STAT_TIMER2     2           // TIMER2_OVF_vect (RTC)
+#define ISR_STAT_DISPLAY    3           // TIMER0_OVF_vect (Helligkeit der Anzeige, DISPLAY_BCM)
+#define ISR_STAT_COUNT      4
+
+/* Histogramm: Klasse b enthält Werte von 2^b bis 2^(b+1)-1 Ticks
+   (Klasse 0: 0..1, letzte Klasse: alles darüber) */
+#define ISR_STAT_BUCKETS    8
+
+typedef struct
+{
+    uint16_t count;                     // Anzahl Aufrufe (bleibt bei 0xFFFF stehen)
+    uint16_t min, max;                  // [Timer1-Ticks]
+    uint16_t hist[ISR_STAT_BUCKETS];    // (Zähler bleiben bei 0xFFFF stehen)
+} IsrStat;
+
+#ifdef ISR_STATS
+
+#define ISR_STATS_ENTER()           uint16_t isr_stats_t0 = TCNT1
+#define ISR_STATS_EXIT(id)          isr_stats_record(&isr_stat_time[id], TCNT1 - isr_stats_t0)
+#define ISR_STATS_LATENCY(id, due)  isr_stats_record(&isr_stat_latency[id], isr_stats_t0 - (due))
+
+extern IsrStat isr_stat_time[ISR_STAT_COUNT];
+extern IsrStat isr_stat_latency[ISR_STAT_COUNT];
+
+/* Startet Timer1 als freilaufende Zeitbasis und löscht die Statistik */
+void isr_stats_init(void);
+
+/* Erfasst einen Messwert (aus der ISR) */
+void isr_stats_record(IsrStat *s, uint16_t ticks);
+
+/* Löscht die Statistik */
+void isr_stats_reset(void);
+
+/* Ausgabe: je Interrupt die Kennung, dann IsrStat für Laufzeit und Latenz
+   (Little Endian, wie im Speicher) */
+#define ISR_STAT_DUMP_ENTRY (1 + 2 * sizeof(IsrStat))
+#define ISR_STAT_DUMP_BYTES (ISR_STAT_COUNT * ISR_STAT_DUMP_ENTRY)
+
+/* Gibt höchstens n Byte der Ausgabe ab Position pos an put (Position, Byte)
+   weiter. Die Werte eines Interrupts werden bei seiner Kennung konsistent
+   kopiert. Rückgabe: Position für den nächsten Aufruf, ISR_STAT_DUMP_BYTES
+   am Ende. Anfordern über LINK_ISR (link.h) */
+uint8_t isr_stats_dump(uint8_t pos, uint8_t n, void (*put)(uint8_t pos, uint8_t byte));
+
+#else
+
+#define ISR_STATS_ENTER()
+#define ISR_STATS_EXIT(id)
+#define ISR_STATS_LATENCY(id, due)
+
+#endif // ISR_STATS
+
+#endif // ISRSTAT_H
@@ -0,0 +1,182 @@
+#include "kinematics.h"
+#include "pwm.h"
+#include <avr/pgmspace.h>
+
+/* atan(i/32) für i = 0..32 in 1/16 Grad */
+static const uint16_t atan_table[33] PROGMEM =
+{
+    0, 29, 57, 86, 114, 142, 170, 197, 225, 251, 278, 304, 329, 354, 378, 402,
+    425, 448, 470, 491, 512, 532, 552, 571, 590, 608, 626, 642, 659, 675, 690, 705,
+    720
+};
+
+/* sin(2° * i) für i = 0..45 im Format Q14 */
+static const int16_t sin_table[46] PROGMEM =
+{
+    0, 572, 1143, 1713, 2280, 2845, 3406, 3964, 4516, 5063, 5604, 6138,
+    6664, 7182, 7692, 8192, 8682, 9162, 9630, 10087, 10531, 10963, 11381, 11786,
+    12176, 12551, 12911, 13255, 13583, 13894, 14189, 14466, 14726, 14968, 15191, 15396,
+    15582, 15749, 15897, 16026, 16135, 16225, 16294, 16344, 16374, 16384
+};
+
+uint16_t kin_isqrt(uint32_t value)
+{
+    uint32_t root = 0;
+    uint32_t bit = 1UL << 30;
+
+    while (bit > value)
+        bit >>= 2;
+    while (bit != 0)
+    {
+        if (value >= root + bit)
+        {
+            value -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else
+        {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (uint16_t)root;
+}
+
+/* atan(num/den) für 0 <= num <= den, Ergebnis 0 .. 720 (0° .. 45°) */
+static int16_t atan_octant(uint32_t num, uint32_t den)
+{
+    uint16_t t, a, b;
+    uint8_t i;
+
+    if (den == 0)
+        return 0;
+    t = (uint16_t)((num * 256 + den / 2) / den);    // tan in 1/256
+    i = t >> 3;
+    if (i >= 32)
+        return 720;
+    a = pgm_read_word(&atan_table[i]);
+    b = pgm_read_word(&atan_table[i + 1]);
+    return a + (((b - a) * (t & 7) + 4) >> 3);
+}
+
+int16_t kin_atan2(int32_t y, int32_t x)
+{
+    uint32_t ax = (x < 0) ? -x : x;
+    uint32_t ay = (y < 0) ? -y : y;
+    int16_t angle;
+
+    while ((ax | ay) > 0xFFFFFFUL)                  // Überlauf bei num * 256 vermeiden
+    {
+        ax >>= 1;
+        ay >>= 1;
+    }
+    if (ay <= ax)
+        angle = atan_octant(ay, ax);
+    else
+        angle = KIN_DEG(90) - atan_octant(ax, ay);
+    if (x < 0)
+        angle = KIN_DEG(180) - angle;
+    return (y < 0) ? -angle : angle;
+}
+
+int16_t kin_sin(int16_t angle)
+{
+    uint16_t a;
+    uint8_t negative = 0;
+    uint8_t i;
+    int16_t s0, s1;
+
+    while (angle < 0)
+        angle += KIN_DEG(360);
+    while (angle >= KIN_DEG(360))
+        angle -= KIN_DEG(360);
+    a = angle;
+    if (a >= KIN_DEG(180))
+    {
+        a -= KIN_DEG(180);
+        negative = 1;
+    }
+    if (a > KIN_DEG(90))
+        a = KIN_DEG(180) - a;
+
+    i = a >> 5;                                     // 2°-Raster
+    s0 = pgm_read_word(&sin_table[i]);
+    s1 = (i < 45) ? (int16_t)pgm_read_word(&sin_table[i + 1]) : s0;
+    s0 += (int16_t)(((int32_t)(s1 - s0) * (a & 31) + 16) >> 5);
+    return negative ? -s0 : s0;
+}
+
+int16_t kin_cos(int16_t angle)
+{
+    return kin_sin(angle + KIN_DEG(90));
+}
+
+/* Kosinussatz: Winkel zwischen den Seiten a und c gegenüber der Seite b */
+static int16_t triangle_angle(int32_t a, int32_t b, int32_t c, uint8_t *ok)
+{
+    int32_t num = a * a + c * c - b * b;
+    int32_t den = 2 * a * c;
+
+    while (den > 32767 || num > 32767 || num < -32767)
+    {
+        den >>= 1;
+        num >>= 1;
+    }
+    if (num > den)
+    {
+        num = den;
+        *ok = 0;
+    }
+    else if (num < -den)
+    {
+        num = -den;
+        *ok = 0;
+    }
+    return kin_atan2(kin_isqrt((uint32_t)(den * den - num * num)), num);
+}
+
+/* Winkel [1/16 Grad] relativ zum Servo-Nullpunkt -> Servowinkel [°] */
+static uint8_t servo_angle(int16_t null_us, int16_t angle)
+{
+    int16_t pulse;
+
+    // 650 µs/rad = 0,709 µs pro 1/16 Grad ~ 363/512
+    pulse = null_us + (int16_t)(((int32_t)angle * 363) >> 9);
+    if (pulse <= MIN_PULSE_WIDTH)
+        return 0;
+    if (pulse >= MAX_PULSE_WIDTH)
+        return 180;
+    return (uint8_t)(((uint32_t)(pulse - MIN_PULSE_WIDTH) * 180 + (MAX_PULSE_WIDTH - MIN_PULSE_WIDTH) / 2)
+                     / (MAX_PULSE_WIDTH - MIN_PULSE_WIDTH));
+}
+
+uint8_t kin_inverse(int16_t x, int16_t y, uint8_t *left, uint8_t *right)
+{
+    int32_t dx, dy;
+    int16_t c, a1, a2, hx, hy, phi;
+    uint8_t ok = 1;
+
+    /* Dreieck linkes Servo - Armgelenk - Stift */
+    dx = x - KIN_O1X;
+    dy = y - KIN_O1Y;
+    c = kin_isqrt(dx * dx + dy * dy);
+    a1 = kin_atan2(dy, dx);
+    a2 = triangle_angle(KIN_L1, KIN_L2, c, &ok);
+    *left = servo_angle(KIN_LEFT_NULL_US, a1 + a2 - KIN_DEG(180));
+
+    /* Gelenkpunkt des rechten Unterarms (36,5° Versatz am Stiftende) */
+    a2 = triangle_angle(KIN_L2, KIN_L1, c, &ok);
+    phi = a1 - a2 + 569 + KIN_DEG(180);             // 0,621 rad = 569/16 Grad
+    hx = x + (int16_t)(((int32_t)KIN_L3 * kin_cos(phi)) >> 14);
+    hy = y + (int16_t)(((int32_t)KIN_L3 * kin_sin(phi)) >> 14);
+
+    /* Dreieck rechtes Servo - Armgelenk - Gelenkpunkt */
+    dx = hx - KIN_O2X;
+    dy = hy - KIN_O2Y;
+    c = kin_isqrt(dx * dx + dy * dy);
+    a1 = kin_atan2(dy, dx);
+    a2 = triangle_angle(KIN_L1, KIN_L4, c, &ok);
+    *right = servo_angle(KIN_RIGHT_NULL_US, a1 - a2);
+
+    return ok;
+}
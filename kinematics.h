@@ -0,0 +1,43 @@
+#ifndef KINEMATICS_H
+#define KINEMATICS_H
+
+#include <stdint.h>
+
+/* Festkomma-Einheiten:
+   - Längen/Positionen in 1/16 mm (int16_t)
+   - Winkel in 1/16 Grad (int16_t, Vollkreis = 5760)
+   - sin/cos im Format Q14 (16384 = 1,0) */
+#define KIN_MM(mm)          ((int16_t)((mm) * 16))
+#define KIN_DEG(deg)        ((int16_t)((deg) * 16))
+#define KIN_ONE             16384
+
+/* Geometrie der Plotclock (Werte aus dem Arduino-Sketch) */
+#define KIN_L1      KIN_MM(35)          // Oberarm (an beiden Servos)
+#define KIN_L2      KIN_MM(55.1)        // Unterarm links bis Stift
+#define KIN_L3      KIN_MM(13.2)        // Versatz Stift -> Gelenk des rechten Unterarms
+#define KIN_L4      KIN_MM(45)          // Unterarm rechts
+#define KIN_O1X     KIN_MM(22)          // Drehpunkt linkes Servo
+#define KIN_O1Y     KIN_MM(-25)
+#define KIN_O2X     KIN_MM(47)          // Drehpunkt rechtes Servo
+#define KIN_O2Y     KIN_MM(-25)
+
+/* Servo-Abgleich: Pulsbreite [µs] = NULL + FAKTOR * Winkel [rad] */
+#define KIN_LEFT_NULL_US    2250
+#define KIN_RIGHT_NULL_US    920
+#define KIN_US_PER_RAD       650
+
+/* Integer-Wurzel */
+uint16_t kin_isqrt(uint32_t value);
+
+/* Winkel des Vektors (x, y) in 1/16 Grad, Bereich -2880 .. 2880 */
+int16_t kin_atan2(int32_t y, int32_t x);
+
+/* Sinus/Kosinus eines Winkels in 1/16 Grad, Ergebnis Q14 */
+int16_t kin_sin(int16_t angle);
+int16_t kin_cos(int16_t angle);
+
+/* Inverse Kinematik: Stiftposition (1/16 mm) -> Servowinkel links/rechts [°].
+   Rückgabe 0, falls der Punkt außerhalb der Reichweite liegt (Winkel dann begrenzt) */
+uint8_t kin_inverse(int16_t x, int16_t y, uint8_t *left, uint8_t *right);
+
+#endif // KINEMATICS_H
@@ -0,0 +1,250 @@
+#include "link.h"
+
+#ifdef LINK
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/pgmspace.h>
+#include <util/atomic.h>
+#include <util/crc16.h>
+#include "trace.h"
+#include "servo.h"
+#include "motion.h"
+#include "plot.h"
+#include "calib.h"
+#include "isrstat.h"
+
+#define RX_HUNT     0xFF                // Empfänger wartet auf LINK_SOF
+#define ISR_RESERVE 4                   // Plätze im Protokollpuffer, die die ISR-Statistik frei lässt
+
+static const uint8_t link_length[LINK_TYPES] PROGMEM = LINK_LENGTHS;
+
+LinkStats link_stats;
+
+/* Vorrat: head schreibt nur die Empfangs-ISR, tail nur link_run() */
+static LinkFrame link_queue[LINK_QUEUE];
+static volatile uint8_t link_head;
+static volatile uint8_t link_tail;
+static volatile uint8_t link_ack = 0xFF;    // Folgenummer des zuletzt angenommenen Rahmens
+static volatile uint8_t link_errors;        // verworfene Rahmen (zählt nur die ISR)
+static volatile uint8_t link_synced;        // LINK_SYNC empfangen: Stand in jedem Fall melden
+
+/* Empfangszustand (ISR) */
+static LinkFrame rx;
+static uint8_t rx_seq;
+static uint8_t rx_pos = RX_HUNT;            // Byte nach LINK_SOF
+static uint8_t rx_len;
+static uint16_t rx_crc;
+
+/* Zuletzt gemeldeter Stand (Hauptprogramm) */
+static uint8_t report_ack = 0xFF;
+static uint8_t report_free = 0xFF;
+static uint8_t report_errors;
+static uint8_t idle;                        // leere Zyklen in Folge
+#ifdef ISR_STATS
+static uint8_t isr_dump = ISR_STAT_DUMP_BYTES;  // nächstes Byte der angeforderten ISR-Statistik
+#endif
+
+static void stat_inc(uint16_t *counter, uint8_t n)
+{
+    *counter = (*counter > 0xFFFF - n) ? 0xFFFF : *counter + n;
+}
+
+#ifdef ISR_STATS
+static void isr_put(uint8_t pos, uint8_t byte)
+{
+    trace(TRACE_ISR, pos, byte);
+}
+#endif
+
+void link_enable(uint8_t on)
+{
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        rx_pos = RX_HUNT;
+        if (on)
+            UCSRB |= (1 << RXEN) | (1 << RXCIE);
+        else
+            UCSRB &= ~((1 << RXEN) | (1 << RXCIE));
+    }
+}
+
+uint8_t link_poll(void)
+{
+    /* Erst die Folgenummer, dann den Füllstand lesen: nimmt die ISR
+       dazwischen einen Rahmen an, fällt die Gutschrift nur kleiner aus */
+    uint8_t ack = link_ack;
+    uint8_t used = (link_head - link_tail) & (LINK_QUEUE - 1);
+    uint8_t free = LINK_QUEUE - 1 - used;
+    uint8_t errors = link_errors;
+    uint8_t synced = link_synced;
+
+    /* Auch nach verworfenen Rahmen melden: der PC wiederholt dann ab ack + 1 */
+    if (synced || ack != report_ack || free != report_free || errors != report_errors)
+    {
+        if (synced)
+            link_synced = 0;
+        stat_inc(&link_stats.errors, (uint8_t)(errors - report_errors));
+        TRACE_EVENT(TRACE_LINK, free, ack);
+        report_ack = ack;
+        report_free = free;
+        report_errors = errors;
+    }
+#ifdef ISR_STATS
+    /* angeforderte ISR-Statistik, soweit der Protokollpuffer Platz hat */
+    if (isr_dump < ISR_STAT_DUMP_BYTES && trace_free() > ISR_RESERVE)
+        isr_dump = isr_stats_dump(isr_dump, trace_free() - ISR_RESERVE, isr_put);
+#endif
+    return used != 0;
+}
+
+/* Stift abheben und direkt in die Parkposition (Lage nach Servosätzen unbekannt) */
+static void link_park(void)
+{
+    uint8_t left, right;
+
+    idle = 0;
+    servo_move(SERVO_LIFT, MOTION_LIFT_HIGH);
+    servo_commit();
+    servo_wait();
+    kin_inverse(PLOT_PARK_X, PLOT_PARK_Y, &left, &right);
+    servo_move(SERVO_LEFT, left);
+    servo_move(SERVO_RIGHT, right);
+    servo_commit();
+    servo_wait();
+}
+
+uint8_t link_run(void)
+{
+    const LinkFrame *f;
+    uint8_t left, right;
+
+    link_poll();
+    cal_idle();                         // LINK_CAL-Änderungen byteweise ins EEPROM
+    if (link_tail == link_head)
+    {
+        if (++idle >= LINK_TIMEOUT)
+        {
+            link_park();
+            return 0;
+        }
+        /* Fehlzyklus: die PWM wiederholt den letzten Satz */
+        stat_inc(&link_stats.underruns, 1);
+        TRACE_EVENT(TRACE_UNDERRUN, (uint8_t)link_stats.underruns, link_stats.underruns >> 8);
+        pwm_wait_frame();
+        return 1;
+    }
+    idle = 0;
+
+    f = &link_queue[link_tail];
+    switch (f->type)
+    {
+    case LINK_SERVO:
+        servo_move(SERVO_LIFT, f->data[0]);
+        servo_move(SERVO_LEFT, f->data[1]);
+        servo_move(SERVO_RIGHT, f->data[2]);
+        break;
+    case LINK_POS:
+        kin_inverse((int16_t)(f->data[0] | (f->data[1] << 8)),
+                    (int16_t)(f->data[2] | (f->data[3] << 8)), &left, &right);
+        servo_move(SERVO_LIFT, f->data[4]);
+        servo_move(SERVO_LEFT, left);
+        servo_move(SERVO_RIGHT, right);
+        break;
+    case LINK_CAL:
+        if (f->data[0] == 0xFF)
+            cal_reset();
+        else
+            cal_set(f->data[0], f->data[1], f->data[2] | (f->data[3] << 8));
+        link_tail = (link_tail + 1) & (LINK_QUEUE - 1);
+        pwm_wait_frame();               // Satz unverändert, Zyklus abwarten (EEPROM später)
+        return 1;
+    case LINK_ISR:
+#ifdef ISR_STATS
+        isr_dump = 0;                   // Ausgabe über link_poll()
+#endif
+        link_tail = (link_tail + 1) & (LINK_QUEUE - 1);
+        pwm_wait_frame();
+        return 1;
+    default:                            // LINK_END
+        link_tail = (link_tail + 1) & (LINK_QUEUE - 1);
+        link_park();
+        return 0;
+    }
+    link_tail = (link_tail + 1) & (LINK_QUEUE - 1);
+    servo_commit();
+    stat_inc(&link_stats.frames, 1);
+    return 1;
+}
+
+/* Empfang eines Bytes. Die CRC läuft über den ganzen Rahmen einschließlich
+   der übertragenen CRC (low zuerst); bei fehlerfreiem Rahmen ergibt das 0 */
+ISR(USART_RXC_vect)
+{
+    uint8_t status = UCSRA;
+    uint8_t c = UDR;
+    uint8_t next;
+
+    if (status & ((1 << FE) | (1 << DOR)))
+    {
+        if (rx_pos != RX_HUNT)
+            link_errors++;
+        rx_pos = RX_HUNT;
+        return;
+    }
+    if (rx_pos == RX_HUNT)
+    {
+        if (c == LINK_SOF)
+        {
+            rx_pos = 0;
+            rx_crc = 0xFFFF;
+        }
+        return;
+    }
+
+    rx_crc = _crc_ccitt_update(rx_crc, c);
+    if (rx_pos == 0)
+        rx_seq = c;
+    else if (rx_pos == 1)
+    {
+        if (c >= LINK_TYPES)
+        {
+            link_errors++;
+            rx_pos = RX_HUNT;
+            return;
+        }
+        rx.type = c;
+        rx_len = pgm_read_byte(&link_length[c]);
+    }
+    else if (rx_pos < 2 + rx_len)
+        rx.data[rx_pos - 2] = c;
+    else if (rx_pos == 3 + rx_len)
+    {
+        /* Rahmen vollständig */
+        rx_pos = RX_HUNT;
+        if (rx_crc != 0)
+        {
+            link_errors++;
+            return;
+        }
+        if (rx.type == LINK_SYNC)
+        {
+            link_ack = rx_seq;
+            link_synced = 1;
+            return;
+        }
+        next = (link_head + 1) & (LINK_QUEUE - 1);
+        if (rx_seq != (uint8_t)(link_ack + 1) || next == link_tail)
+        {
+            link_errors++;
+            return;
+        }
+        link_queue[link_head] = rx;
+        link_head = next;
+        link_ack = rx_seq;
+        return;
+    }
+    rx_pos++;
+}
+
+#endif // LINK
@@ -0,0 +1,94 @@
+#ifndef LINK_H
+#define LINK_H
+
+#include <stdint.h>
+
+/* Zeichnen vom PC aus: der PC schickt Servo- oder Stiftpositionen über
+   RXD (PD0), die Uhr gibt genau einen Satz pro PWM-Zyklus (20 ms) aus.
+   Nur mit -DLINK übersetzt; setzt -DTRACE voraus, denn Quittungen und
+   Fehlzyklen laufen als Einträge des Ablaufprotokolls zurück (trace.h).
+
+   PD0 ist zugleich der DCF-Eingang: der Empfänger ist nur eingeschaltet,
+   solange das DCF-Modul stromlos ist (Betriebsarten IDLE, PWM, STREAM).
+
+   Rahmen PC -> Uhr:
+     LINK_SOF, seq, Typ, Nutzdaten (Länge je Typ), CRC16 (low, high)
+   Die CRC (CCITT, wie _crc_ccitt_update aus avr-libc, Startwert 0xFFFF)
+   läuft über seq, Typ und Nutzdaten.
+
+   Flusskontrolle über Gutschriften: die Uhr meldet mit TRACE_LINK die
+   Zahl freier Plätze (a) und die Folgenummer des zuletzt angenommenen
+   Rahmens (b). Der PC darf Rahmen bis einschließlich seq = b + a senden.
+   Angenommen wird nur die erwartete Folgenummer; nach CRC-Fehlern oder
+   verlorenen Bytes wiederholt der PC ab b + 1 (go-back-N).
+
+   Läuft der Vorrat während der Ausgabe leer, bleibt der letzte Satz
+   stehen und der Fehlzyklus wird gezählt (TRACE_UNDERRUN). Nach
+   LINK_TIMEOUT leeren Zyklen oder einem LINK_END fährt die Uhr den Stift
+   in die Parkposition und zeigt wieder die Uhrzeit.
+
+   LINK_CAL ändert eine Stützstelle der Servokennlinien (calib.h); Kanal
+   0xFF setzt alle Kennlinien linear. Der Rahmen belegt einen Zyklus ohne
+   neuen Satz, wirksam wird die Änderung mit dem nächsten LINK_SERVO/
+   LINK_POS. Ins EEPROM schreibt link_run() sie nebenher, ein Byte je
+   Zyklus (alle Kennlinien 44 Zyklen, danach weiter im Leerlauf); Ausgabe
+   und Gutschriften laufen dabei ungebremst weiter. So lassen sich die
+   Kennlinien ohne neues Flashen am Gerät abgleichen (tools/linkhost.cpp).
+
+   LINK_ISR fordert die Laufzeit- und Latenzstatistik der Interrupts an
+   (nur mit -DISR_STATS, sonst wirkungslos; isrstat.h). Die Uhr schickt
+   sie als TRACE_ISR-Einträge (Position, Byte), nur soweit im Puffer des
+   Ablaufprotokolls Platz bleibt, auch über LINK_END hinaus (link_poll()
+   im Leerlauf). Der Rahmen belegt wie LINK_CAL einen Zyklus. */
+#define LINK_SOF        0xA5
+#define LINK_QUEUE      16              // Plätze im Vorrat (Zweierpotenz, einer bleibt frei)
+#define LINK_TIMEOUT    50              // leere Zyklen bis zum Ende (1 s)
+
+/* Rahmentypen und Länge der Nutzdaten */
+#define LINK_SYNC       0               // -, setzt die erwartete Folgenummer auf seq + 1
+#define LINK_SERVO      1               // Winkel Hub, links, rechts [°]
+#define LINK_POS        2               // x, y [1/16 mm, int16 little endian], Hubwinkel [°]
+#define LINK_END        3               // -, Ende der Übertragung
+#define LINK_CAL        4               // Kanal, Stützstelle, Pulsbreite [µs, uint16 little endian]
+#define LINK_ISR        5               // -, ISR-Statistik anfordern
+#define LINK_TYPES      6
+
+#define LINK_PAYLOAD    5               // größte Nutzdatenlänge
+#define LINK_LENGTHS    { 0, 3, 5, 0, 4, 0 }
+
+/* Ein Eintrag im Vorrat */
+typedef struct
+{
+    uint8_t type;
+    uint8_t data[LINK_PAYLOAD];
+} LinkFrame;
+
+#ifdef LINK
+
+#ifndef TRACE
+#error "LINK setzt TRACE voraus (Quittungen über das Ablaufprotokoll)"
+#endif
+
+/* Zähler seit dem Start (bleiben bei 0xFFFF stehen) */
+typedef struct
+{
+    uint16_t frames;                    // ausgegebene Sätze
+    uint16_t underruns;                 // Zyklen ohne neuen Satz während der Übertragung
+    uint16_t errors;                    // verworfene Rahmen (CRC, Format, Folgenummer, voll)
+} LinkStats;
+
+extern LinkStats link_stats;
+
+/* Empfänger ein-/ausschalten (nur bei stromlosem DCF-Modul einschalten) */
+void link_enable(uint8_t on);
+
+/* Meldet neue Gutschriften; liefert 1, sobald Sätze zur Ausgabe bereitliegen */
+uint8_t link_poll(void);
+
+/* Gibt einen Satz aus und wartet bis zum Zyklusende.
+   Rückgabe 0, wenn die Übertragung beendet ist (Stift geparkt) */
+uint8_t link_run(void);
+
+#endif // LINK
+
+#endif // LINK_H
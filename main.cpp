@@ -4,18 +4,35 @@
 #include <util/delay.h>
 #include "dcf77.h"
 #include "pwm.h"
-
-/* Definition der Ausgänge für die Anzeige (z.B. Stunden und Minuten) */
-#define H_PORT  PORTC
-#define H_DDR   DDRC
-#define M_PORT  PORTB
-#define M_DDR   DDRB
+#include "servo.h"
+#include "calib.h"
+#include "ticks.h"
+#include "isrstat.h"
+#include "plot.h"
+#include "trace.h"
+#include "link.h"
+#include "stats.h"
+#include "warm.h"
+#include "bench.h"
+#include "display.h"
 
 #define MODUS_IDLE  (1<<0)
 #define MODUS_DCF   (1<<1)
 #define MODUS_PWM   (1<<2)
 #define PWR_DCF     (1<<3)
 
+/* Zulässige Abweichung der RTC bei der regelmäßigen Synchronisation [min]
+   (Übernahme dann schon nach Bit 35, siehe dcf_expect) */
+#define RESYNC_WINDOW   2
+
+/* Aussichtslose Synchronisation (dcf77.h): Minuten bis zum nächsten
+   Versuch und Wartezeit nach dem nächsten Abbruch. Abgebrochen wird nur,
+   wenn seit dem Einschalten schon einmal synchronisiert wurde; die Uhrzeit
+   eines Warmstarts ist unbestätigt, bis dahin bleibt der Empfänger an */
+static uint8_t dcf_retry = 0;
+static uint8_t dcf_backoff = DCF_RETRY_MINUTES;
+static uint8_t rtc_valid = 0;
+
 /* RTC-Variablen (wird von Timer2-ISR aktualisiert) */
 volatile uint8_t second_flag = 0;
 volatile uint8_t rtc_seconds = 0;
@@ -34,18 +51,45 @@ void init_TCNT2_RTC(void)
 }
 
 /* Funktion, um den Timer2-Zähler (RTC) zurückzusetzen.
-   (wird vom DCF77-Decoder bei erfolgreicher Synchronisation genutzt) */
-static void reset_TCNT2(void)
+   (wird vom DCF77-Decoder bei erfolgreicher Synchronisation genutzt;
+   second und fraction siehe dcf_getPhase) */
+static void reset_TCNT2(uint8_t second, uint8_t fraction)
 {
-    rtc_seconds = 0;
-    TCNT2 = 0;
+    rtc_seconds = second;
+    second_flag = 0;         // angefangene Sekunde der alten Phase verwerfen
+    ticks_restart_second(fraction);  // Tickzähler läuft dabei stetig weiter
     while (ASSR & ((1 << OCR2UB) | (1 << TCR2UB) | (1 << TCN2UB)));
 }
 
+/* Abweichung der RTC von der DCF-Zeit h:m:s + fraction/256 in 1/256 s
+   (positiv: RTC geht vor); mit gesperrten Interrupts aufrufen */
+static int32_t rtc_error(uint8_t h, uint8_t m, uint8_t s, uint8_t fraction)
+{
+    const int32_t day = 86400L * TICKS_PER_SECOND;
+    int32_t rtc, dcf, error;
+    uint8_t t = TCNT2;
+
+    rtc = ((int32_t)(rtc_hours * 60 + rtc_minutes) * 60 + rtc_seconds) * TICKS_PER_SECOND + t;
+    if (second_flag)
+        rtc += TICKS_PER_SECOND;        // Sekunde abgelaufen, aber noch nicht gezählt
+    if ((TIFR & (1 << TOV2)) && t < 128)
+        rtc += TICKS_PER_SECOND;        // Überlauf steht noch an
+    dcf = ((int32_t)(h * 60 + m) * 60 + s) * TICKS_PER_SECOND + fraction;
+    error = (rtc - dcf) % day;
+    if (error > day / 2)
+        error -= day;
+    if (error < -day / 2)
+        error += day;
+    return error;
+}
+
 /* Timer2 Overflow-Interrupt: setzt eine Flagge für die RTC */
 ISR(TIMER2_OVF_vect)
 {
+    ISR_STATS_ENTER();
     second_flag = 1;
+    ticks_overflow();
+    ISR_STATS_EXIT(ISR_STAT_TIMER2);
 }
 
 void enable_dcf_timer()
@@ -56,20 +100,7 @@ void enable_dcf_timer()
 
 void disable_dcf_timer()
 {
-    TIMSK &= ~(1 << TOIE0);  // Timer0-Interrupt deaktivieren
-    TCCR0 = 0;               // Timer0 stoppen
-}
-
-void enable_pwm_timer()
-{
-    init_TCNT1_PWM(); // Timer1 für PWM neu initialisieren
-}
-
-void disable_pwm_timer()
-{
-    TIMSK &= ~(1 << TOIE1);  // Timer1-Interrupt deaktivieren
-    TCCR1A = 0;
-    TCCR1B = 0;
+    stop_TCNT0_DCF();        // Abtastung anhalten (Timer0 bzw. Timer1 Compare B)
 }
 
 void goToSleep()
@@ -83,11 +114,17 @@ void goToSleep()
     sleep_disable(); // Sleep deaktivieren (verhindert erneutes Einschlafen sofort nach Wake-Up)
 }
 
-/* Aktualisiert die Anzeige (hier beispielhaft: Stunden auf PORTC, Minuten auf PORTB) */
-void update_display(uint8_t hours, uint8_t minutes)
+/* Liefert die Uhrzeit der folgenden Minute (für die Vorbereitung des Zeichnens) */
+static void next_minute(uint8_t *hours, uint8_t *minutes)
 {
-    H_PORT = hours;
-    M_PORT = minutes;
+    *hours = rtc_hours;
+    *minutes = rtc_minutes + 1;
+    if (*minutes >= 60)
+    {
+        *minutes = 0;
+        if (++*hours >= 24)
+            *hours = 0;
+    }
 }
 
 /* --- Zustandsmaschine --- */
@@ -95,36 +132,86 @@ typedef enum
 {
     MODE_IDLE, // Nur RTC läuft (Binäranzeige oder sonstige Standardanzeige)
     MODE_PWM,  // PWM-Sequenz (z. B. "Aufzeichnung" tagsüber)
-    MODE_DCF   // DCF-Synchronisation (bei Systemstart oder zu Sync-Zeiten)
+    MODE_DCF,  // DCF-Synchronisation (bei Systemstart oder zu Sync-Zeiten)
+    MODE_STREAM // Zeichnen vom PC aus (link.h, nur mit -DLINK)
 } SystemMode;
 
 volatile SystemMode currentMode = MODE_DCF;
 volatile uint8_t ctrl = 0b00001010;//start in MODE_DCF & PWR_DCF
 
+/* Wechsel der Betriebsart (mit Eintrag im Ablaufprotokoll) */
+static void set_mode(SystemMode mode)
+{
+    TRACE_EVENT(TRACE_MODE, mode, currentMode);
+    currentMode = mode;
+}
+
+/* Bricht die Synchronisation ab: Empfänger aus, Zeit bis zum nächsten
+   Versuch verdoppeln */
+static void dcf_abort(void)
+{
+    disable_dcf_timer();
+    ctrl ^= (MODUS_IDLE|MODUS_DCF|PWR_DCF);
+    DCF_PORT &= ~DCF_PWR;
+#ifdef LINK
+    link_enable(1);                 // PD0 frei für den PC
+#endif
+    STATS_INC(sync_aborted);
+    stats.rx_wasted += dcf_quality.seconds;
+    dcf_retry = dcf_backoff;
+    dcf_backoff = dcf_backoff > DCF_RETRY_MAX / 2 ? DCF_RETRY_MAX : dcf_backoff * 2;
+    set_mode(MODE_IDLE);
+}
+
 int main(void)
 {
-    /* Port-Konfiguration für Anzeige */
-    H_DDR = 0xFF;
-    M_DDR = 0xFF;
+#ifdef BENCH
+    bench_run();         // Messlauf statt Uhrbetrieb (bench.h), kehrt nicht zurück
+#endif
+
+    /* Port-Konfiguration für Anzeige (Stunden auf PORTC, Minuten auf PORTB, siehe display.h) */
+    display_init();
 
     /* Konfiguration des DCF77-Moduls:
        - DCF_PWR-Pin als Ausgang, DCF-Modul einschalten */
     DCF_DDR |= DCF_PWR;
     DCF_PORT |= DCF_PWR;
 
-    /* PWM-Konfiguration (Details in pwm.h/pwm.cpp vorausgesetzt) */
-    PWM_DDR |= PWM_KEYS;
+    /* PWM-Konfiguration: Ausgänge laut PWM_PINS (pwm.h) */
+    pwm_init();
+#ifdef TRACE
+    trace_init();        // Ablaufprotokoll über TXD (PD1)
+#endif
+#ifdef ISR_STATS
+    isr_stats_init();    // Timer1 als Zeitbasis der ISR-Statistik
+#endif
 
     /* Globale Pull-ups deaktivieren */
     SFIOR |= (1 << PUD);
 
     /* Initialisierungen der Timer */
-    init_TCNT0_DCF();    // DCF77-Modul Timer0 zur Decodierung, wird wie TCNT1 nur bei Bedarf aktiviert
-//    init_TCNT1_PWM();    // (Aus PWM-Modul)
+    init_TCNT0_DCF();    // DCF77-Abtastung (Timer0 oder mit DCF_SAMPLE_TIMER1 Timer1 Compare B, siehe dcf77.h)
+                         // (ohne Mitnutzung startet und stoppt Timer1 mit der PWM-Ausgabe, siehe pwm.h)
     init_TCNT2_RTC();    // RTC aktivieren
 
     /* Initiale PWM-Einstellungen */
-    set_pwm(0,0,0);
+    cal_load();          // Servokennlinien aus dem EEPROM
+    stats_load();        // Langzeitzähler aus dem EEPROM
+    uint8_t warm_h, warm_m;
+    if (warm_load(&warm_h, &warm_m))
+    {
+        /* Warmstart: gesicherte Uhrzeit sofort anzeigen, DCF bestätigt sie
+           schon nach Bit 35 der ersten vollständigen Minute */
+        rtc_hours = warm_h;
+        rtc_minutes = warm_m;
+        dcf_expect(warm_h, warm_m, WARM_WINDOW);
+    }
+    display_show(rtc_hours, rtc_minutes);
+    display_hour(rtc_hours);
+    STATS_INC(sync_attempts);   // Start im DCF-Modus
+    servo_init();
+    plot_init();
+    pwm_off();
 
     /* Schlafmodus aktivieren */
 //    set_sleep_mode(SLEEP_MODE_IDLE);//urspgl. SLEEP_MODE_PWR_SAVE
@@ -137,31 +224,65 @@ int main(void)
         if (second_flag)
         {
             second_flag = 0;
-            rtc_seconds++;
+            if (ctrl & PWR_DCF)
+            {
+                STATS_INC(rx_seconds);
+                if (dcf_quality_second() && rtc_valid)
+                    dcf_abort();    // Empfang hoffnungslos gestört
+            }
+            rtc_seconds += warm_second();   // mit Ausgleich der Gangabweichung
             if (rtc_seconds >= 60)
             {
-                rtc_seconds = 0;
+                rtc_seconds -= 60;
                 rtc_minutes++;
                 if (rtc_minutes >= 60)
                 {
                     rtc_minutes = 0;
                     rtc_hours++;
                     if (rtc_hours >= 24)
+                    {
                         rtc_hours = 0;
+                        plot_new_day();
+                    }
                 }
-                update_display(rtc_hours, rtc_minutes);//minute-wise
+                display_show(rtc_hours, rtc_minutes);//minute-wise
+                display_hour(rtc_hours);        // Helligkeit nach Tageszeit
+                stats_minute();
+                warm_minute();
+                if (dcf_retry)
+                    dcf_retry--;
+                if (currentMode == MODE_IDLE)
+                    set_mode(MODE_PWM); // neue Uhrzeit zeichnen (ist bereits vorbereitet)
             }
         }
         switch(currentMode)
         {
         case MODE_IDLE:
-            if(!get_dcf_sync())
+            if(!get_dcf_sync() && !dcf_retry)
             {
                 /* in DCF77-Modus wechseln */
+#ifdef LINK
+                link_enable(0);     // PD0 gehört wieder dem DCF-Modul
+#endif
                 ctrl ^= (MODUS_IDLE|MODUS_DCF);
-                currentMode = MODE_DCF;
+                dcf_expect(rtc_hours, rtc_minutes, RESYNC_WINDOW);
+                STATS_INC(sync_attempts);
+                set_mode(MODE_DCF);
+            }
+#ifdef LINK
+            else if (link_poll())
+            {
+                set_mode(MODE_STREAM);  // Sätze vom PC liegen bereit
+                break;
             }
-            /*if(rtc_minutes%2) currentMode = MODE_PWM;*/
+#endif
+            /* Leerlauf nutzen: Zeichnen der nächsten Minute vorbereiten */
+            uint8_t next_h, next_m;
+            next_minute(&next_h, &next_m);
+            plot_prepare(next_h, next_m);
+            stats_idle();   // Langzeitzähler sichern, falls fällig
+            warm_idle(rtc_hours, rtc_minutes);  // Uhrzeit für den Warmstart sichern, falls fällig
+            cal_idle();     // geänderte Servokennlinien ins EEPROM (ein Byte je Durchlauf)
             /* Optional: Zu definierten Zeiten erneute Synchronisation anstoßen */
             if ((rtc_hours == 5 && rtc_minutes == 45) || (rtc_hours == 18 && rtc_minutes == 48))
             {
@@ -182,59 +303,75 @@ int main(void)
                     enable_dcf_timer();
                     ctrl |= PWR_DCF;
                 }
+                dcf_quality_reset();
             }
 
             dcf_process(); // DCF-Daten auswerten
 
-            uint8_t dcf_h, dcf_m;
+            uint8_t dcf_h, dcf_m, dcf_s, dcf_frac;
+            int32_t rtc_err;
             dcf_getTime(&dcf_h, &dcf_m);
 
             if (dcf_h != 0xFF && dcf_m != 0xFF) // Nur übernehmen, wenn valide
             {
+                dcf_getPhase(&dcf_s, &dcf_frac);
                 ATOMIC_BLOCK(ATOMIC_FORCEON)
                 {
+                    rtc_err = rtc_error(dcf_h, dcf_m, dcf_s, dcf_frac);
+#ifdef TRACE
+                    /* Abweichung der RTC in Minuten (auf +-127 begrenzt) */
+                    int16_t corr = (int16_t)(dcf_h * 60 + dcf_m) - (int16_t)(rtc_hours * 60 + rtc_minutes);
+                    if (corr > 127) corr = 127;
+                    if (corr < -127) corr = -127;
+                    TRACE_EVENT(TRACE_RTC, rtc_seconds, (uint8_t)(int8_t)corr);
+#endif
                     /* Aktualisiere die RTC-Uhr (hier beispielhaft direkt) */
                     rtc_hours = dcf_h;
                     rtc_minutes = dcf_m;
-                    reset_TCNT2(); // RTC Timer zurücksetzen
+                    reset_TCNT2(dcf_s, dcf_frac); // RTC Timer zurücksetzen
                     disable_dcf_timer();
-                    update_display(rtc_hours, rtc_minutes);
+                    display_show(rtc_hours, rtc_minutes);
+                    display_hour(rtc_hours);
                     ctrl ^= (MODUS_IDLE|MODUS_DCF|PWR_DCF); //aufräumen: zurücksetzen der Modi, ausschalten PWR_DCF
                     DCF_PORT &= ~DCF_PWR;           //Strom aus
+#ifdef LINK
+                    link_enable(1);                 // PD0 frei für den PC
+#endif
                     //set_dcf_sync(1);//ist schon gesetzt in ISR DCF
-                    currentMode = MODE_IDLE;
+                    STATS_INC(sync_ok);
+                    rtc_valid = 1;
+                    dcf_backoff = DCF_RETRY_MINUTES;
+                    set_mode(MODE_IDLE);
                 }
+                warm_synced(rtc_err);   // Gangabweichung nachführen, Uhrzeit sichern
             }
             break;
         case MODE_PWM:
-            if(!ctrl&MODUS_PWM)
+            if(!(ctrl&MODUS_PWM))
             {
-                ATOMIC_BLOCK(ATOMIC_FORCEON)
-                {
-                    enable_pwm_timer();
-                    ctrl |= MODUS_PWM;
-                }
-            }
-            /* Beispiel: Eine PWM-Sequenz ausführen */
-            for(int it = 0; it < 5; it++)
-            {
-                for (int i = 0; i < 256; i++)
-                {
-                    set_pwm(0,i,0);
-                    pwm_update();
-                    //_delay_ms(20);
-                }
+                ctrl |= MODUS_PWM;
+                plot_begin(rtc_hours, rtc_minutes);
             }
+            /* Einen Servozyklus der aktuellen Uhrzeit ausgeben */
+            if (plot_run())
+                break;
 
-            ATOMIC_BLOCK(ATOMIC_FORCEON)
-            {
-                disable_pwm_timer();
-                ctrl &= ~MODUS_PWM;
-                currentMode = MODE_IDLE;
-            }
+            pwm_off(); // Servos stromlos, Timer1 aus
+            ctrl &= ~MODUS_PWM;
+            set_mode(MODE_IDLE);
+            break;
+#ifdef LINK
+        case MODE_STREAM:
+            if (link_run())
+                break;
+
+            pwm_off();
+            plot_init();    // Tafelinhalt unbekannt: zur nächsten Minute alles neu
+            set_mode(MODE_IDLE);
             break;
+#endif
         default:
-            update_display(rtc_hours, rtc_minutes);
+            display_show(rtc_hours, rtc_minutes);
         }
         /* OPTIONAL Energiesparmodus: Sleep, bis ein Interrupt (RTC oder Timer0) erwacht */
     }
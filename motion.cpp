@@ -0,0 +1,142 @@
+#include "motion.h"
+
+MotionStats motion_stats;
+
+/* Zustand der laufenden Bewegung */
+static int16_t pen_x, pen_y;            // Ziel (bzw. Ruheposition)
+static int16_t start_x, start_y;        // Startpunkt
+static int16_t delta_x, delta_y;        // Weg
+static uint8_t arm_left, arm_right;     // Servowinkel am Ziel
+static uint8_t lift = MOTION_LIFT_UP;   // Stellung Hubservo
+static uint8_t total;                   // Zyklen der Bewegung (N)
+static uint8_t ramp;                    // Zyklen je Rampe (ta)
+static uint8_t step;                    // aktueller Zyklus (k)
+
+void motion_init(int16_t x, int16_t y)
+{
+    pen_x = start_x = x;
+    pen_y = start_y = y;
+    delta_x = delta_y = 0;
+    total = step = 0;
+    kin_inverse(x, y, &arm_left, &arm_right);
+}
+
+int16_t motion_x(void)
+{
+    return pen_x;
+}
+
+int16_t motion_y(void)
+{
+    return pen_y;
+}
+
+#ifndef MOTION_NAIVE
+/* Legt Dauer (total) und Rampenlänge (ramp) der Bewegung nach (x, y) fest */
+static void plan_profile(uint16_t length, int16_t x, int16_t y)
+{
+    uint16_t n;
+    uint8_t left, right, frames;
+
+    /* Trapez: Rampe mit MOTION_ACCEL_FRAMES, sonst Dreieck mit kürzerer Rampe */
+    if (length >= (uint16_t)MOTION_VMAX * MOTION_ACCEL_FRAMES)
+    {
+        ramp = MOTION_ACCEL_FRAMES;
+        n = (length + MOTION_VMAX - 1) / MOTION_VMAX + ramp;
+    }
+    else
+    {
+        ramp = kin_isqrt(((uint32_t)length * MOTION_ACCEL_FRAMES + MOTION_VMAX - 1) / MOTION_VMAX);
+        if (ramp == 0)
+            ramp = 1;
+        n = 2 * ramp;
+    }
+
+    /* Zeitskalierung: das langsamere Armservo bestimmt die Dauer */
+    kin_inverse(x, y, &left, &right);
+    frames = servo_travel_frames(SERVO_LEFT, arm_left, left);
+    if (servo_travel_frames(SERVO_RIGHT, arm_right, right) > frames)
+        frames = servo_travel_frames(SERVO_RIGHT, arm_right, right);
+    arm_left = left;
+    arm_right = right;
+    if (n < (uint16_t)frames + ramp)
+        n = frames + ramp;
+
+    total = (n > 255) ? 255 : (uint8_t)n;
+}
+#endif
+
+void motion_start(int16_t x, int16_t y)
+{
+    uint16_t length;
+
+    start_x = pen_x;
+    start_y = pen_y;
+    delta_x = x - pen_x;
+    delta_y = y - pen_y;
+    pen_x = x;
+    pen_y = y;
+    step = 0;
+    motion_stats.moves++;
+
+    length = kin_isqrt((int32_t)delta_x * delta_x + (int32_t)delta_y * delta_y);
+    if (length == 0)
+    {
+        total = 0;
+        return;
+    }
+#ifdef MOTION_NAIVE
+    ramp = 0;
+    total = 1;
+    kin_inverse(x, y, &arm_left, &arm_right);
+#else
+    plan_profile(length, x, y);
+#endif
+}
+
+/* Anteil des Weges nach k Zyklen im Format Q16 (Trapezprofil) */
+static uint32_t profile(uint8_t k)
+{
+    uint32_t cruise = total - ramp;     // D = N - ta
+
+    if (ramp == 0 || k >= total)
+        return 65536UL;
+    if (k <= ramp)
+        return ((uint32_t)k * k << 16) / (2UL * ramp * cruise);
+    if (k <= total - ramp)
+        return ((uint32_t)(2 * k - ramp) << 16) / (2UL * cruise);
+    k = total - k;
+    return 65536UL - (((uint32_t)k * k << 16) / (2UL * ramp * cruise));
+}
+
+uint8_t motion_next(ServoFrame *frame)
+{
+    uint32_t f;
+    int16_t x, y;
+
+    if (step >= total)
+        return 0;
+    step++;
+    f = profile(step);
+    x = start_x + (int16_t)(((int32_t)delta_x * (int32_t)f + 32768L) >> 16);
+    y = start_y + (int16_t)(((int32_t)delta_y * (int32_t)f + 32768L) >> 16);
+
+    frame->angle[SERVO_LIFT] = lift;
+    kin_inverse(x, y, &frame->angle[SERVO_LEFT], &frame->angle[SERVO_RIGHT]);
+    return 1;
+}
+
+void motion_output(const ServoFrame *frame)
+{
+    uint8_t ch;
+
+    for (ch = 0; ch < SERVO_COUNT; ch++)
+        servo_move(ch, frame->angle[ch]);
+    servo_commit();
+    motion_stats.frames++;
+}
+
+void motion_set_lift(uint8_t angle)
+{
+    lift = angle;
+}
@@ -0,0 +1,61 @@
+#ifndef MOTION_H
+#define MOTION_H
+
+#include <stdint.h>
+#include "servo.h"
+#include "kinematics.h"
+
+/* Bahnplanung im Stiftraum (Positionen in 1/16 mm, siehe kinematics.h).
+   Jede Bewegung folgt einem Trapezprofil (Beschleunigen, Fahren, Bremsen),
+   das genau einmal pro PWM-Zyklus (20 ms) abgetastet wird. Die Dauer wird so
+   gestreckt, dass keines der beiden Armservos seine Stellgeschwindigkeit
+   überschreitet; beide Arme erreichen das Ziel im selben Zyklus.
+   Mit MOTION_NAIVE wird zum Vergleich direkt auf das Ziel gesprungen;
+   plot.cpp hält den Zyklus dann so lange, wie die Arme laut
+   Bewegungsmodell für Weg und Beruhigung brauchen (servo_move_frames). */
+#define MOTION_VMAX         13          // max. Stiftgeschwindigkeit [1/16 mm pro Zyklus] (~40 mm/s)
+#define MOTION_ACCEL_FRAMES  5          // Zyklen für die Rampe 0 -> MOTION_VMAX
+
+/* Stellungen des Hubservos [°] */
+#define MOTION_LIFT_DRAW    52          // Stift auf der Tafel (1080 µs)
+#define MOTION_LIFT_UP      38          // zwischen den Ziffern (925 µs)
+#define MOTION_LIFT_HIGH    20          // über den Wischer (725 µs)
+
+/* Ein Satz Servowinkel für genau einen PWM-Zyklus */
+typedef struct
+{
+    uint8_t angle[SERVO_COUNT];
+} ServoFrame;
+
+/* Zähler zum Vergleich Profil / MOTION_NAIVE */
+typedef struct
+{
+    uint16_t moves;                     // geplante Bewegungen
+    uint32_t frames;                    // dafür benötigte PWM-Zyklen (inkl. Wartezeit)
+} MotionStats;
+
+extern MotionStats motion_stats;
+
+/* Setzt die angenommene Stiftposition (z. B. Parkposition) ohne Bewegung.
+   Bahnplanung und Ausgabe sind getrennt: geplant wird immer ab dieser bzw.
+   der zuletzt geplanten Position, auch wenn die Zyklen erst später ausgegeben werden */
+void motion_init(int16_t x, int16_t y);
+
+/* Plant eine gerade Bewegung von der aktuellen Position nach (x, y) */
+void motion_start(int16_t x, int16_t y);
+
+/* Liefert den nächsten Zyklus der geplanten Bewegung.
+   Rückgabe 0, wenn die Bewegung abgeschlossen ist */
+uint8_t motion_next(ServoFrame *frame);
+
+/* Gibt einen Zyklus an die PWM aus (wartet auf den Zyklusbeginn) */
+void motion_output(const ServoFrame *frame);
+
+/* Setzt die Stellung des Hubservos für die folgenden Zyklen (ohne Ausgabe) */
+void motion_set_lift(uint8_t angle);
+
+/* Aktuelle (bzw. zuletzt geplante) Stiftposition */
+int16_t motion_x(void);
+int16_t motion_y(void);
+
+#endif // MOTION_H
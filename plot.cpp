@@ -0,0 +1,921 @@
+#include "plot.h"
+#include "glyph.h"
+#include "stroke.h"
+#include <avr/pgmspace.h>
+#ifdef PLOT_FRAME_CACHE
+#include "plotcache.h"
+#endif
+
+#define NO_TIME     0xFF
+
+/* Arbeitsschritte des Ablaufs */
+#define ITEM_ERASE  0                   // Tafel wischen
+#define ITEM_DRAW   1                   // Pfade in geplanter Reihenfolge zeichnen
+#define ITEM_PARK   2                   // zurück in Parkposition
+#define ITEM_DONE   3
+
+/* Laufende Operation */
+typedef enum
+{
+    OP_NONE,
+    OP_LIFT,                            // Hubservo stellen (ein Zyklus + Wartezyklen)
+    OP_TRAVEL,                          // Fahrt mit Trapezprofil (motion)
+    OP_STROKE,                          // Strichelement (stroke)
+    OP_REPLAY,                          // vorberechneter Zug (plotcache.h)
+    OP_DONE
+} PlotOp;
+
+/* Ein erzeugter Servozyklus; hold = Anzahl folgender Zyklen ohne Änderung */
+typedef struct
+{
+    ServoFrame frame;
+    uint8_t hold;
+} PlotFrame;
+
+/* Zusammenhängender Zug einer Glyphe: GLYPH_MOVE und folgende Zeichenelemente */
+typedef struct
+{
+    uint8_t cell;                       // Zelle der Anzeige
+    uint8_t first;                      // Index des GLYPH_MOVE in der Glyphe
+    uint8_t count;                      // Anzahl Zeichenelemente
+    uint8_t reverse;                    // rückwärts zeichnen (vom Ende zum Anfang)
+#ifdef PLOT_FRAME_CACHE
+    uint8_t track;                      // vorberechneter Zug oder CACHE_NONE
+#endif
+    int16_t sx, sy;                     // Anfangspunkt
+    int16_t ex, ey;                     // Endpunkt
+} PlotPath;
+
+#ifdef PLOT_FRAME_CACHE
+/* Wiedergabe eines vorberechneten Zugs (plotcache.h) */
+typedef struct
+{
+    uint16_t code;                      // nächstes Halbbyte in cache_codes
+    uint16_t stop;                      // Ende (vorwärts) bzw. Anfang (rückwärts) des Zugs
+    uint8_t left, right;                // zuletzt ausgegebene Armwinkel [°]
+    uint8_t reverse;                    // rückwärts: Codes vom Ende her abziehen
+} PlotReplay;
+#endif
+
+/* Stand der Erzeugung (Checkpoint) */
+typedef struct
+{
+    uint8_t hours, minutes;             // Uhrzeit, die erzeugt wird
+    uint8_t erase;                      // zu wischende Zellen (Bitmaske)
+    uint8_t draw;                       // zu zeichnende Zellen (Bitmaske)
+    uint8_t item;                       // Arbeitsschritt (ITEM_...)
+    uint8_t path;                       // laufender Pfad bei ITEM_DRAW
+    uint8_t paths;                      // Anzahl Pfade
+    uint8_t index;                      // Element innerhalb des Arbeitsschritts
+    uint8_t run;                        // Wischbereich (von rechts gezählt)
+    uint8_t op;                         // laufende Operation (PlotOp)
+    uint8_t lift;                       // geplante Stellung des Hubservos
+    int16_t x, y;                       // geplante Stiftposition
+    uint16_t penup_fixed;               // Weg mit abgehobenem Stift: Glyphenreihenfolge
+    uint16_t penup_planned;             //  - geplante Reihenfolge [1/16 mm]
+    ServoFrame last;                    // zuletzt erzeugter Zyklus
+#ifdef PLOT_FRAME_CACHE
+    PlotReplay replay;
+#else
+    StrokeGen gen;
+#endif
+} PlotJob;
+
+static PlotJob job;
+static PlotPath paths[PLOT_MAX_PATHS];  // in Zeichenreihenfolge
+
+PlotStats plot_stats;
+
+static uint8_t board[PLOT_CELLS];       // gezeichnete Glyphe je Zelle (NO_TIME = unbekannt)
+static uint16_t job_frames;             // Startstand der Zykluszähler des Auftrags
+static uint32_t job_travel;
+
+static PlotFrame buffer[PLOT_BUFFER_FRAMES];
+static uint8_t buf_head, buf_tail, buf_count;
+static uint8_t hold;                    // verbleibende Wartezyklen bei der Ausgabe
+
+/* Zellursprünge HH:MM (x in 1/16 mm) */
+static const int16_t cell_x[PLOT_CELLS] PROGMEM =
+{
+    KIN_MM(5), KIN_MM(19), KIN_MM(28), KIN_MM(34), KIN_MM(48)
+};
+
+/* Ausdehnung der Zellen (x von .. bis in 1/16 mm) für Wischbahn und Schwamm */
+static const int16_t cell_extent[PLOT_CELLS][2] PROGMEM =
+{
+    { KIN_MM(5),  KIN_MM(16) }, { KIN_MM(19), KIN_MM(30) }, { KIN_MM(32), KIN_MM(33) },
+    { KIN_MM(34), KIN_MM(45) }, { KIN_MM(48), KIN_MM(59) }
+};
+
+/* Zeilen der Zickzack-Wischbahn (y in 1/16 mm, von oben nach unten) */
+static const int16_t erase_rows[] PROGMEM =
+{
+    KIN_MM(49), KIN_MM(45), KIN_MM(40), KIN_MM(35), KIN_MM(30), KIN_MM(25), KIN_MM(20)
+};
+#define ERASE_ROWS      (sizeof(erase_rows) / sizeof(erase_rows[0]))
+#define ERASE_POINTS    (2 * ERASE_ROWS)
+
+/* Ablauf des Wischens (job.index) */
+#define ERASE_GRIP      0               // Schwamm in Parkposition greifen
+#define ERASE_OUT       1               // Schwamm herausziehen
+#define ERASE_ZIGZAG    2               // 2 .. 2 + ERASE_POINTS - 1: Bahn des Bereichs job.run
+#define ERASE_LIFT      (ERASE_ZIGZAG + ERASE_POINTS)
+#define ERASE_BACK      (ERASE_LIFT + 1)
+#define ERASE_LOWER     (ERASE_BACK + 1)
+#define ERASE_PARK      (ERASE_LOWER + 1)
+#define ERASE_RELEASE   (ERASE_PARK + 1)
+
+#define ERASE_GRIP_X    KIN_MM(70)
+#define ERASE_GRIP_Y    KIN_MM(46)
+#define ERASE_BACK_X    KIN_MM(60)
+#define ERASE_BACK_Y    KIN_MM(44)
+
+/* Grenzen des n-ten zusammenhängenden Bereichs in mask (von rechts gezählt).
+   Rückgabe: Zellen des Bereichs (Bitmaske), 0 wenn es keinen solchen gibt */
+static uint8_t erase_run(uint8_t mask, uint8_t n, int16_t *left, int16_t *right)
+{
+    int8_t cell = PLOT_CELLS - 1;
+    int8_t last;
+
+    for (;;)
+    {
+        while (cell >= 0 && !(mask & (1 << cell)))
+            cell--;
+        if (cell < 0)
+            return 0;
+        last = cell;
+        while (cell >= 0 && (mask & (1 << cell)))
+            cell--;
+        if (n-- == 0)
+        {
+            *left = pgm_read_word(&cell_extent[cell + 1][0]);
+            *right = pgm_read_word(&cell_extent[last][1]);
+            return (uint8_t)((2 << last) - (1 << (cell + 1)));
+        }
+    }
+}
+
+/* Zellen, die der Schwamm beim Wischen von mask mit streift */
+static uint8_t erase_damage(uint8_t mask)
+{
+    uint8_t damage = 0;
+    uint8_t e, c;
+    int16_t left, right;
+
+    for (e = 0; e < PLOT_CELLS; e++)
+    {
+        if (!(mask & (1 << e)))
+            continue;
+        left = pgm_read_word(&cell_extent[e][0]) - PLOT_SPONGE_HALF;
+        right = pgm_read_word(&cell_extent[e][1]) + PLOT_SPONGE_HALF;
+        for (c = 0; c < PLOT_CELLS; c++)
+        {
+            if ((int16_t)pgm_read_word(&cell_extent[c][0]) <= right &&
+                    (int16_t)pgm_read_word(&cell_extent[c][1]) >= left)
+                damage |= 1 << c;
+        }
+    }
+    return damage & ~mask;
+}
+
+/* Glyphe für Zelle cell bei der Uhrzeit hours:minutes */
+static constexpr uint8_t time_glyph(uint8_t cell, uint8_t hours, uint8_t minutes)
+{
+    switch (cell)
+    {
+    case 0:
+        return hours / 10;
+    case 1:
+        return hours % 10;
+    case 3:
+        return minutes / 10;
+    case 4:
+        return minutes % 10;
+    default:
+        return GLYPH_COLON;
+    }
+}
+
+/* Glyphe für Zelle cell bei der Uhrzeit des Auftrags */
+static uint8_t cell_glyph(uint8_t cell)
+{
+    return time_glyph(cell, job.hours, job.minutes);
+}
+
+#ifdef PLOT_FRAME_CACHE
+/* Ohne Strichgeneratoren muss jede Glyphe, die eine Uhrzeit in ihrer
+   Zelle ergeben kann, als Zug vorliegen */
+static constexpr uint16_t cache_glyph_masks[PLOT_CELLS] = CACHE_GLYPH_MASKS;
+
+static constexpr bool cache_complete(void)
+{
+    for (uint8_t h = 0; h < 24; h++)
+        for (uint8_t m = 0; m < 60; m++)
+            for (uint8_t c = 0; c < PLOT_CELLS; c++)
+                if (!(cache_glyph_masks[c] & (1 << time_glyph(c, h, m))))
+                    return false;
+    return true;
+}
+static_assert(cache_complete(), "plotcache.h enthält nicht alle Glyphen der Uhrzeiten, mit tools/framegen neu erzeugen");
+#endif
+
+/* Abstand zweier Punkte in 1/16 mm */
+static uint16_t distance(int16_t x0, int16_t y0, int16_t x1, int16_t y1)
+{
+    int32_t dx = x1 - x0;
+    int32_t dy = y1 - y0;
+
+    return kin_isqrt((uint32_t)(dx * dx + dy * dy));
+}
+
+/* Eintritts- und Austrittspunkt eines Pfads in Zeichenrichtung;
+   außerhalb der Pfade (n < 0 oder n >= job.paths) die Parkposition */
+static void path_entry(int8_t n, int16_t *x, int16_t *y)
+{
+    if (n < 0 || n >= job.paths)
+    {
+        *x = PLOT_PARK_X;
+        *y = PLOT_PARK_Y;
+    }
+    else
+    {
+        *x = paths[n].reverse ? paths[n].ex : paths[n].sx;
+        *y = paths[n].reverse ? paths[n].ey : paths[n].sy;
+    }
+}
+
+static void path_exit(int8_t n, int16_t *x, int16_t *y)
+{
+    if (n < 0 || n >= job.paths)
+    {
+        *x = PLOT_PARK_X;
+        *y = PLOT_PARK_Y;
+    }
+    else
+    {
+        *x = paths[n].reverse ? paths[n].sx : paths[n].ex;
+        *y = paths[n].reverse ? paths[n].sy : paths[n].ey;
+    }
+}
+
+/* Weg mit abgehobenem Stift von Pfad a zu Pfad b (-1/job.paths = Park) */
+static uint16_t path_gap(int8_t a, int8_t b)
+{
+    int16_t x0, y0, x1, y1;
+
+    path_exit(a, &x0, &y0);
+    path_entry(b, &x1, &y1);
+    return distance(x0, y0, x1, y1);
+}
+
+static uint16_t path_cost(void)
+{
+    uint16_t cost = 0;
+    int8_t n;
+
+    for (n = -1; n < (int8_t)job.paths; n++)
+        cost += path_gap(n, n + 1);
+    return cost;
+}
+
+/* Zerlegt die zu zeichnenden Zellen in Pfade (Glyphenreihenfolge) */
+static void plan_paths(void)
+{
+    GlyphStroke g;
+    PlotPath *p = paths;
+    uint8_t cell, i;
+    int16_t ox;
+#ifdef PLOT_FRAME_CACHE
+    uint8_t track;
+#endif
+
+    job.paths = 0;
+    for (cell = 0; cell < PLOT_CELLS; cell++)
+    {
+        if (!(job.draw & (1 << cell)))
+            continue;
+        ox = pgm_read_word(&cell_x[cell]);
+#ifdef PLOT_FRAME_CACHE
+        track = pgm_read_byte(&cache_glyph[cell][cell_glyph(cell)]);
+#endif
+        for (i = 0; glyph_read(cell_glyph(cell), i, &g); i++)
+        {
+            if (g.type == GLYPH_MOVE)
+            {
+                if (job.paths == PLOT_MAX_PATHS)
+                    return;
+                p = &paths[job.paths++];
+                p->cell = cell;
+                p->first = i;
+                p->count = 0;
+                p->reverse = 0;
+#ifdef PLOT_FRAME_CACHE
+                p->track = track;       // Züge einer Glyphe liegen hintereinander
+                if (track != CACHE_NONE)
+                    track++;
+#endif
+                glyph_end(&g, ox, PLOT_CELL_Y, &p->sx, &p->sy);
+                p->ex = p->sx;
+                p->ey = p->sy;
+            }
+            else
+            {
+                p->count++;
+                glyph_end(&g, ox, PLOT_CELL_Y, &p->ex, &p->ey);
+            }
+        }
+    }
+}
+
+/* Ordnet die Pfade für kurzen Weg mit abgehobenem Stift:
+   nächster Nachbar ab der Parkposition, danach 2-opt. Eine Umkehr des
+   Abschnitts i..j kehrt auch die Zeichenrichtung jedes Pfads darin um;
+   i = j dreht nur einen Pfad. */
+static void plan_order(void)
+{
+    PlotPath t;
+    uint8_t budget = PLOT_OPT_BUDGET;
+    uint8_t improved, best, reverse;
+    int8_t i, j, n;
+    uint16_t d, dmin;
+    int16_t x, y, x0, y0, x1, y1;
+
+    /* nächster Nachbar */
+    x = PLOT_PARK_X;
+    y = PLOT_PARK_Y;
+    for (i = 0; i < job.paths; i++)
+    {
+        dmin = UINT16_MAX;
+        best = i;
+        reverse = 0;
+        for (j = i; j < job.paths; j++)
+        {
+            d = distance(x, y, paths[j].sx, paths[j].sy);
+            if (d < dmin)
+            {
+                dmin = d;
+                best = j;
+                reverse = 0;
+            }
+            d = distance(x, y, paths[j].ex, paths[j].ey);
+            if (d < dmin)
+            {
+                dmin = d;
+                best = j;
+                reverse = 1;
+            }
+        }
+        t = paths[i];
+        paths[i] = paths[best];
+        paths[best] = t;
+        paths[i].reverse = reverse;
+        path_exit(i, &x, &y);
+    }
+
+    /* 2-opt bis keine Verbesserung mehr oder das Budget erschöpft ist */
+    do
+    {
+        improved = 0;
+        for (i = 0; i < job.paths; i++)
+        {
+            for (j = i; j < job.paths; j++)
+            {
+                if (budget-- == 0)
+                    return;
+                /* alt: exit(i-1)->entry(i), exit(j)->entry(j+1)
+                   neu: exit(i-1)->exit(j),  entry(i)->entry(j+1) */
+                path_exit(i - 1, &x0, &y0);
+                path_exit(j, &x1, &y1);
+                d = distance(x0, y0, x1, y1);
+                path_entry(i, &x0, &y0);
+                path_entry(j + 1, &x1, &y1);
+                d += distance(x0, y0, x1, y1);
+                if (d >= path_gap(i - 1, i) + path_gap(j, j + 1))
+                    continue;
+                for (n = i; n <= j; n++)
+                    paths[n].reverse ^= 1;
+                for (n = 0; n < (j - i + 1) / 2; n++)
+                {
+                    t = paths[i + n];
+                    paths[i + n] = paths[j - n];
+                    paths[j - n] = t;
+                }
+                improved = 1;
+            }
+        }
+    }
+    while (improved);
+}
+
+static void plot_reset(uint8_t hours, uint8_t minutes)
+{
+    uint8_t cell;
+
+    job.hours = hours;
+    job.minutes = minutes;
+
+    /* Differenz zur Tafel: nur geänderte Zellen wischen und zeichnen */
+    job.erase = 0;
+    for (cell = 0; cell < PLOT_CELLS && hours != NO_TIME; cell++)
+    {
+        if (board[cell] != cell_glyph(cell))
+            job.erase |= 1 << cell;
+    }
+    job.draw = job.erase | erase_damage(job.erase);
+
+    plan_paths();
+    job.penup_fixed = path_cost();
+#ifndef PLOT_FIXED_ORDER
+    plan_order();
+#endif
+    job.penup_planned = path_cost();
+
+    job.item = (job.draw != 0) ? ITEM_ERASE : ITEM_DONE;
+    job.path = 0;
+    job.index = 0;
+    job.run = 0;
+    job.op = OP_NONE;
+    job.lift = MOTION_LIFT_HIGH;
+    job.x = PLOT_PARK_X;
+    job.y = PLOT_PARK_Y;
+    job.last.angle[SERVO_LIFT] = job.lift;
+    kin_inverse(job.x, job.y, &job.last.angle[SERVO_LEFT], &job.last.angle[SERVO_RIGHT]);
+    motion_init(job.x, job.y);
+    motion_set_lift(job.lift);
+    buf_head = buf_tail = buf_count = 0;
+    hold = 0;
+}
+
+void plot_init(void)
+{
+    uint8_t cell;
+
+    for (cell = 0; cell < PLOT_CELLS; cell++)
+        board[cell] = NO_TIME;
+    plot_reset(NO_TIME, NO_TIME);
+}
+
+uint16_t plot_average_frames(void)
+{
+    if (plot_stats.redraws == 0)
+        return 0;
+    return (uint16_t)(plot_stats.frames / plot_stats.redraws);
+}
+
+void plot_new_day(void)
+{
+    plot_stats.travel_yesterday = plot_stats.travel_today;
+    plot_stats.travel_today = 0;
+}
+
+/* Auftrag vollständig ausgegeben: Tafel und Statistik nachführen */
+static void plot_finish(void)
+{
+    uint8_t cell;
+
+    for (cell = 0; cell < PLOT_CELLS; cell++)
+        board[cell] = cell_glyph(cell);
+    if (job.draw != 0)
+    {
+        plot_stats.redraws++;
+        plot_stats.frames += (uint16_t)(pwm_get_frames() - job_frames);
+        plot_stats.travel_today += servo_travel - job_travel;
+        plot_stats.penup_fixed += job.penup_fixed;
+        plot_stats.penup_planned += job.penup_planned;
+    }
+    job.hours = job.minutes = NO_TIME;
+}
+
+/* Punkt zig der Zickzack-Wischbahn über den Bereich left .. right */
+static void erase_point(uint8_t zig, int16_t left, int16_t right, int16_t *x, int16_t *y)
+{
+    *x = (((zig + 1) >> 1) & 1) ? left : right;
+    *y = pgm_read_word(&erase_rows[zig >> 1]);
+}
+
+#ifdef PLOT_FRAME_CACHE
+/* Beginnt die Wiedergabe des vorberechneten Zugs track; rückwärts startet
+   sie an dessen Ende. Die Stiftposition danach setzt der Aufrufer */
+static uint8_t plan_replay(uint8_t track, uint8_t reverse)
+{
+    const CacheTrack *t = &cache_tracks[track];
+    uint16_t first = pgm_read_word(&t->offset);
+    uint16_t end = pgm_read_word(&t[1].offset);
+
+    job.replay.reverse = reverse;
+    if (reverse)
+    {
+        job.replay.code = end;
+        job.replay.stop = first;
+        job.replay.left = pgm_read_byte(&t->end[0]);
+        job.replay.right = pgm_read_byte(&t->end[1]);
+    }
+    else
+    {
+        job.replay.code = first;
+        job.replay.stop = end;
+        job.replay.left = pgm_read_byte(&t->start[0]);
+        job.replay.right = pgm_read_byte(&t->start[1]);
+    }
+    return OP_REPLAY;
+}
+
+/* Halbbyte n aus cache_codes, vorzeichenbehaftet erweitert */
+static int8_t replay_code(uint16_t n)
+{
+    uint8_t b = pgm_read_byte(&cache_codes[n >> 1]);
+
+    if (!(n & 1))
+        b >>= 4;
+    return (int8_t)(b << 4) >> 4;
+}
+
+/* Nächster Zyklus der Wiedergabe; Rückgabe 0 am Ende des Zugs */
+static uint8_t replay_next(ServoFrame *frame)
+{
+    PlotReplay *r = &job.replay;
+    int8_t code, dl, dr;
+
+    if (r->code == r->stop)
+        return 0;
+    if (r->reverse)
+    {
+        /* rückwärts wird der Stand vor der Änderung ausgegeben, zuletzt der Anfang */
+        code = replay_code(--r->code) & 0x0F;
+        if (code == CACHE_ESCAPE)
+        {
+            dr = replay_code(--r->code);
+            dl = replay_code(--r->code);
+            r->code--;
+        }
+        else
+        {
+            dl = (code >> 2) - 1;
+            dr = (code & 3) - 1;
+        }
+        r->left -= dl;
+        r->right -= dr;
+    }
+    else
+    {
+        code = replay_code(r->code++) & 0x0F;
+        if (code == CACHE_ESCAPE)
+        {
+            dl = replay_code(r->code++);
+            dr = replay_code(r->code++);
+            r->code++;
+        }
+        else
+        {
+            dl = (code >> 2) - 1;
+            dr = (code & 3) - 1;
+        }
+        r->left += dl;
+        r->right += dr;
+    }
+    frame->angle[SERVO_LEFT] = r->left;
+    frame->angle[SERVO_RIGHT] = r->right;
+    return 1;
+}
+
+/* Vorberechnete Wischbahn für die Zellen run (Bitmaske) oder CACHE_NONE */
+static uint8_t cache_erase(uint8_t run)
+{
+    uint8_t i;
+
+    for (i = 0; i < CACHE_ERASE_RUNS; i++)
+    {
+        if (pgm_read_byte(&cache_erase_runs[i][0]) == run)
+            return pgm_read_byte(&cache_erase_runs[i][1]);
+    }
+    return CACHE_NONE;
+}
+#endif // PLOT_FRAME_CACHE
+
+static uint8_t plan_lift(uint8_t angle)
+{
+    job.index++;
+    job.lift = angle;
+    return OP_LIFT;
+}
+
+static uint8_t plan_travel(int16_t x, int16_t y)
+{
+    job.index++;
+    job.x = x;
+    job.y = y;
+    motion_start(x, y);
+    return OP_TRAVEL;
+}
+
+/* Nächster Schritt des Wischens: Fahrziel (x, y) oder Hubstellung
+   (x = LIFT_MARK, y = Winkel). Rückgabe 0, wenn das Wischen beendet ist */
+#define LIFT_MARK   INT16_MIN
+#define REPLAY_MARK (INT16_MIN + 1)     // Wiedergabe gestartet (y = OP_REPLAY)
+
+static uint8_t plan_erase(int16_t *x, int16_t *y)
+{
+    int16_t left, right;
+    uint8_t zig;
+#ifdef PLOT_FRAME_CACHE
+    uint8_t track;
+#endif
+
+    *x = LIFT_MARK;
+    switch (job.index)
+    {
+    case ERASE_GRIP:
+        *y = MOTION_LIFT_DRAW;
+        return 1;
+    case ERASE_OUT:
+        *x = ERASE_GRIP_X;
+        *y = ERASE_GRIP_Y;
+        return 1;
+    case ERASE_LIFT:
+        if (erase_run(job.erase, job.run + 1, &left, &right))
+        {
+            job.run++;                  // nächster Bereich weiter links
+            job.index = ERASE_ZIGZAG;
+        }
+        else
+        {
+            *y = MOTION_LIFT_UP;        // nicht über ungeänderte Zellen zurückwischen
+            return 1;
+        }
+        break;
+    case ERASE_BACK:
+        *x = ERASE_BACK_X;
+        *y = ERASE_BACK_Y;
+        return 1;
+    case ERASE_LOWER:
+        *y = MOTION_LIFT_DRAW;
+        return 1;
+    case ERASE_PARK:
+        *x = PLOT_PARK_X;
+        *y = PLOT_PARK_Y;
+        return 1;
+    case ERASE_RELEASE:
+        *y = MOTION_LIFT_HIGH;
+        return 1;
+    default:
+        if (job.index > ERASE_RELEASE)
+            return 0;
+        break;
+    }
+
+    /* Zickzack über den Bereich job.run, rechts oben beginnend */
+    zig = job.index - ERASE_ZIGZAG;
+    erase_run(job.erase, job.run, &left, &right);
+    if (zig == 0 && job.run > 0 && job.lift != MOTION_LIFT_UP)
+    {
+        job.index--;                    // zwischen zwei Bereichen angehoben fahren
+        *y = MOTION_LIFT_UP;
+        return 1;
+    }
+    if (zig == 1 && job.lift != MOTION_LIFT_DRAW)
+    {
+        job.index--;
+        *y = MOTION_LIFT_DRAW;
+        return 1;
+    }
+#ifdef PLOT_FRAME_CACHE
+    /* ab dem ersten Punkt mit gesenktem Schwamm vorberechnet */
+    if (zig == 1 && (track = cache_erase(erase_run(job.erase, job.run, &left, &right))) != CACHE_NONE)
+    {
+        job.index = ERASE_LIFT;
+        erase_point(ERASE_POINTS - 1, left, right, &job.x, &job.y);
+        *x = REPLAY_MARK;
+        *y = plan_replay(track, 0);
+        return 1;
+    }
+#endif
+    erase_point(zig, left, right, x, y);
+    return 1;
+}
+
+/* Stufen Glyphen -> Strichelemente: bestimmt die nächste Operation */
+static uint8_t plan_next(void)
+{
+#ifndef PLOT_FRAME_CACHE
+    GlyphStroke g;
+    Stroke s;
+    uint8_t element;
+    int16_t ox;
+#endif
+    PlotPath *p;
+    int16_t x, y;
+
+    for (;;)
+    {
+        if (job.item == ITEM_ERASE)
+        {
+            if (job.erase != 0 && plan_erase(&x, &y))
+            {
+                if (x == LIFT_MARK)
+                    return plan_lift(y);
+#ifdef PLOT_FRAME_CACHE
+                if (x == REPLAY_MARK)
+                    return y;
+#endif
+                return plan_travel(x, y);
+            }
+        }
+        else if (job.item == ITEM_DRAW)
+        {
+            if (job.path >= job.paths)
+            {
+                job.item++;
+                job.index = 0;
+                continue;
+            }
+            p = &paths[job.path];
+            if (job.index == 0)
+            {
+                if (job.lift != MOTION_LIFT_UP)
+                {
+                    job.index--;                // danach erneut zum Anfang des Pfads
+                    return plan_lift(MOTION_LIFT_UP);
+                }
+                path_entry(job.path, &x, &y);
+                return plan_travel(x, y);
+            }
+            if (job.index <= p->count)
+            {
+                if (job.lift != MOTION_LIFT_DRAW)
+                {
+                    job.index--;
+                    return plan_lift(MOTION_LIFT_DRAW);
+                }
+#ifdef PLOT_FRAME_CACHE
+                job.index = p->count + 1;       // ganzer Zug vorberechnet
+                path_exit(job.path, &job.x, &job.y);
+                return plan_replay(p->track, p->reverse);
+#else
+                ox = pgm_read_word(&cell_x[p->cell]);
+                if (p->reverse)
+                {
+                    /* Elemente vom letzten zum ersten, jeweils bis zum Endpunkt
+                       des vorherigen Elements (beim ersten: Punkt des GLYPH_MOVE) */
+                    element = p->first + p->count - job.index;
+                    glyph_read(cell_glyph(p->cell), element, &g);
+                    glyph_end(&g, ox, PLOT_CELL_Y, &x, &y);
+                    glyph_read(cell_glyph(p->cell), element + 1, &g);
+                    glyph_stroke_reverse(&g, ox, PLOT_CELL_Y, job.x, job.y, x, y, &s);
+                }
+                else
+                {
+                    glyph_read(cell_glyph(p->cell), p->first + job.index, &g);
+                    glyph_stroke(&g, ox, PLOT_CELL_Y, job.x, job.y, &s);
+                }
+                job.index++;
+                stroke_begin(&job.gen, &s);
+                return OP_STROKE;
+#endif
+            }
+            job.path++;
+            job.index = 0;
+            continue;
+        }
+        else if (job.item == ITEM_PARK)
+        {
+            if (job.index == 0 && job.lift != MOTION_LIFT_HIGH)
+            {
+                job.index--;
+                return plan_lift(MOTION_LIFT_HIGH);
+            }
+            if (job.index == 0)
+                return plan_travel(PLOT_PARK_X, PLOT_PARK_Y);
+        }
+        else
+        {
+            return OP_DONE;
+        }
+        job.item++;
+        job.index = 0;
+    }
+}
+
+/* Stufen IK -> Servozyklen: erzeugt einen Zyklus in den Puffer.
+   Rückgabe 0, wenn der Puffer voll oder der Auftrag abgeschlossen ist */
+static uint8_t produce(void)
+{
+    PlotFrame *f = &buffer[buf_head];
+    uint8_t from, frames;
+#ifndef PLOT_FRAME_CACHE
+    int16_t x, y;
+#endif
+
+    if (buf_count >= PLOT_BUFFER_FRAMES)
+        return 0;
+    f->hold = 0;
+
+    for (;;)
+    {
+        if (job.op == OP_DONE)
+            return 0;
+        if (job.op == OP_TRAVEL && motion_next(&f->frame))
+        {
+#ifdef MOTION_NAIVE
+            /* Sprung aufs Ziel: stehen lassen, bis beide Arme laut
+               Bewegungsmodell angekommen und ruhig sind */
+            frames = servo_move_frames(SERVO_LEFT, job.last.angle[SERVO_LEFT], f->frame.angle[SERVO_LEFT]);
+            from = servo_move_frames(SERVO_RIGHT, job.last.angle[SERVO_RIGHT], f->frame.angle[SERVO_RIGHT]);
+            if (from > frames)
+                frames = from;
+            f->hold = frames ? frames - 1 : 0;
+#endif
+            break;
+        }
+#ifndef PLOT_FRAME_CACHE
+        if (job.op == OP_STROKE)
+        {
+            if (stroke_next(&job.gen, &x, &y))
+            {
+                job.x = x;
+                job.y = y;
+                f->frame.angle[SERVO_LIFT] = job.lift;
+                kin_inverse(x, y, &f->frame.angle[SERVO_LEFT], &f->frame.angle[SERVO_RIGHT]);
+                break;
+            }
+            motion_init(job.x, job.y);  // Bahnplanung am Strichende fortsetzen
+        }
+#else
+        if (job.op == OP_REPLAY)
+        {
+            if (replay_next(&f->frame))
+            {
+                f->frame.angle[SERVO_LIFT] = job.lift;
+                break;
+            }
+            motion_init(job.x, job.y);
+        }
+#endif
+
+        from = job.lift;
+        job.op = plan_next();
+        if (job.op == OP_LIFT)
+        {
+            f->frame = job.last;
+            f->frame.angle[SERVO_LIFT] = job.lift;
+            frames = servo_move_frames(SERVO_LIFT, from, job.lift);
+            f->hold = frames ? frames - 1 : 0;
+            motion_set_lift(job.lift);
+            job.op = OP_NONE;
+            break;
+        }
+    }
+
+    job.last = f->frame;
+    buf_head = (buf_head + 1) % PLOT_BUFFER_FRAMES;
+    buf_count++;
+    return 1;
+}
+
+void plot_prepare(uint8_t hours, uint8_t minutes)
+{
+    uint8_t i;
+
+    if (job.hours != hours || job.minutes != minutes)
+        plot_reset(hours, minutes);
+    for (i = 0; i < PLOT_PREPARE_FRAMES && produce(); i++);
+}
+
+void plot_begin(uint8_t hours, uint8_t minutes)
+{
+    if (job.hours != hours || job.minutes != minutes)
+        plot_reset(hours, minutes);
+    hold = 0;
+    job_frames = pwm_get_frames();
+    job_travel = servo_travel;
+}
+
+uint8_t plot_run(void)
+{
+    PlotFrame *f;
+
+    /* Vorrat nachfüllen (mehr als ein Zyklus, damit ein Rückstand aufgeholt wird) */
+    produce();
+    produce();
+
+    if (hold)
+    {
+        hold--;
+        pwm_wait_frame();
+        motion_stats.frames++;          // Wartezeit gehört zur Bewegung
+        return 1;
+    }
+    if (buf_count == 0)
+    {
+        if (job.op != OP_DONE)
+            return 1;                   // Erzeugung hinkt hinterher
+        plot_finish();
+        return 0;
+    }
+
+    f = &buffer[buf_tail];
+    motion_output(&f->frame);
+    hold = f->hold;
+    buf_tail = (buf_tail + 1) % PLOT_BUFFER_FRAMES;
+    buf_count--;
+    return 1;
+}
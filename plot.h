@@ -0,0 +1,92 @@
+#ifndef PLOT_H
+#define PLOT_H
+
+#include <stdint.h>
+#include "motion.h"
+
+/* Zeichenablauf je Minute in Stufen:
+   Uhrzeit -> Glyphen -> Strichelemente -> inverse Kinematik -> Servozyklen.
+   Die Zyklen werden in einen begrenzten Ringpuffer erzeugt. Die Erzeugung
+   beginnt bereits in der Leerlaufzeit der vorherigen Minute (plot_prepare)
+   und wird beim Zeichnen (plot_run) an ihrem Stand fortgesetzt, sodass das
+   Zeichnen mit dem Minutenwechsel sofort beginnen kann.
+
+   Der Inhalt der Tafel wird je Zelle gemerkt. Gewischt und neu gezeichnet
+   werden nur geänderte Zellen; der Wischer fährt dabei nur über zusammen-
+   hängende Bereiche geänderter Zellen. Vom Schwamm gestreifte Nachbarzellen
+   werden ohne Wischen nachgezeichnet.
+
+   Die Züge der zu zeichnenden Glyphen (Pfade) werden je Minute neu
+   geordnet und bei Bedarf rückwärts gezeichnet, sodass der Weg mit
+   abgehobenem Stift von der Parkposition über alle Pfade zurück kurz
+   wird: zuerst nächster Nachbar, dann 2-opt mit begrenzter Anzahl
+   Prüfungen. Mit PLOT_FIXED_ORDER wird zum Vergleich in Glyphenreihenfolge
+   gezeichnet.
+
+   Mit PLOT_FRAME_CACHE werden die Züge der Glyphen und die Zickzack-Bahnen
+   der beim Minutenwechsel vorkommenden Wischbereiche nicht berechnet,
+   sondern aus plotcache.h (Flash, ca. 2,6 KB, erzeugt mit tools/framegen)
+   wiedergegeben: je Zyklus ein Halbbyte mit der Änderung der Armwinkel.
+   Berechnet werden dann nur noch die Fahrten zwischen den Zügen; die
+   Strichgeneratoren (stroke.cpp) entfallen. Rückwärts gezeichnete Pfade
+   laufen den Vorwärtszug rückwärts ab und liegen um bis zu 1° neben der
+   Berechnung. Flash mit und ohne Cache: tools/bench/run.sh bzw.
+   BENCH_DEFS=-DPLOT_FRAME_CACHE tools/bench/run.sh. */
+#define PLOT_BUFFER_FRAMES  48          // Vorrat an Servozyklen (4 Byte je Zyklus)
+#define PLOT_PREPARE_FRAMES  4          // max. erzeugte Zyklen je plot_prepare()
+
+/* Pfade je Minute: vier Ziffern mit je einem Zug, Doppelpunkt mit zwei */
+#define PLOT_MAX_PATHS      8
+/* Höchstzahl geprüfter 2-opt-Vertauschungen je Minute (je vier Wurzeln,
+   zwei volle Durchläufe bei sechs Pfaden); die Planung läuft einmal je
+   Minute im Leerlauf (plot_prepare) */
+#define PLOT_OPT_BUDGET     42
+
+/* Zellen der Anzeige: HH:MM (Ursprung links unten, in 1/16 mm) */
+#define PLOT_CELLS          5
+#define PLOT_CELL_Y         KIN_MM(25)
+
+/* Halbe Schwammbreite: so weit wischt der Schwamm über die Bahn hinaus */
+#define PLOT_SPONGE_HALF    KIN_MM(2.5)
+
+/* Parkposition (Stift neben dem Wischer) */
+#define PLOT_PARK_X         KIN_MM(75.2)
+#define PLOT_PARK_Y         KIN_MM(47)
+
+/* Statistik des Zeichnens */
+typedef struct
+{
+    uint16_t redraws;                   // gezeichnete Minuten
+    uint32_t frames;                    // dafür benötigte PWM-Zyklen (20 ms)
+    uint32_t travel_today;              // Servoweg [°] seit Mitternacht
+    uint32_t travel_yesterday;          // Servoweg [°] des Vortags
+    uint32_t penup_fixed;               // Weg mit abgehobenem Stift [1/16 mm]
+                                        //  bei Glyphenreihenfolge
+    uint32_t penup_planned;             //  bei geplanter Reihenfolge
+} PlotStats;
+
+extern PlotStats plot_stats;
+
+/* Mittlere Zeichendauer je Minute in PWM-Zyklen */
+uint16_t plot_average_frames(void);
+
+/* Tageswechsel für die Statistik des Servowegs */
+void plot_new_day(void);
+
+/* Setzt den Zeichenablauf zurück; der Stift wird in Parkposition angenommen
+   und der Inhalt der Tafel als unbekannt (alles wird gewischt) */
+void plot_init(void);
+
+/* Bereitet das Zeichnen der Uhrzeit hours:minutes im Leerlauf vor
+   (erzeugt höchstens PLOT_PREPARE_FRAMES Zyklen je Aufruf) */
+void plot_prepare(uint8_t hours, uint8_t minutes);
+
+/* Beginnt das Zeichnen von hours:minutes; ein passender vorbereiteter Stand
+   wird übernommen */
+void plot_begin(uint8_t hours, uint8_t minutes);
+
+/* Gibt den nächsten Zyklus aus (wartet auf den Zyklusbeginn).
+   Rückgabe 0, sobald die Uhrzeit vollständig gezeichnet ist */
+uint8_t plot_run(void);
+
+#endif // PLOT_H
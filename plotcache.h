@@ -0,0 +1,303 @@
+#ifndef PLOTCACHE_H
+#define PLOTCACHE_H
+
+/* Vorberechnete Servozyklen für plot.cpp (nur mit -DPLOT_FRAME_CACHE).
+   Erzeugt mit tools/framegen.cpp, nicht von Hand ändern; nach Änderungen
+   an Glyphen, Zellen, Wischbahn, Kinematik oder Bewegungsprofil neu
+   erzeugen (./framegen > plotcache.h).
+   35 Züge, 4446 Zyklen, 2618 Byte Flash */
+
+#include <stdint.h>
+#include <avr/pgmspace.h>
+#include "plot.h"
+#include "glyph.h"
+#include "stroke.h"
+
+#ifdef MOTION_NAIVE
+#error "PLOT_FRAME_CACHE enthält das Trapezprofil, nicht mit MOTION_NAIVE"
+#endif
+
+static_assert(GLYPH_SCALE == 115 && PLOT_CELL_Y == 400 && STROKE_STEP == 8 &&
+              MOTION_VMAX == 13 && MOTION_ACCEL_FRAMES == 5 &&
+              SERVO_TRAVEL_US_PER_DEG == 1700 && SERVO_FRAME_US == 20000 &&
+              KIN_L1 == 560 && KIN_L2 == 881 && KIN_L3 == 211 && KIN_L4 == 720 &&
+              KIN_O1X == 352 && KIN_O1Y == -400 && KIN_O2X == 752 && KIN_O2Y == -400,
+              "plotcache.h passt nicht zur Geometrie, mit tools/framegen neu erzeugen");
+
+#define CACHE_NONE          0xFF
+#define CACHE_TRACKS        35
+#define CACHE_ERASE_RUNS    4
+
+/* Je Zyklus ein Halbbyte (oberes zuerst): (links + 1) << 2 | (rechts + 1)
+   für Änderungen der Armwinkel von -1 .. 1°, sonst CACHE_ESCAPE, links,
+   rechts (je -8 .. 7°), CACHE_ESCAPE; damit auch rückwärts lesbar */
+#define CACHE_ESCAPE        0xF
+
+/* Zug: erstes Halbbyte in cache_codes (Ende beim nächsten Eintrag),
+   Armwinkel links/rechts [°] am Anfang und am Ende */
+typedef struct
+{
+    uint16_t offset;
+    uint8_t start[2];
+    uint8_t end[2];
+} CacheTrack;
+
+/* Erster Zug je Zelle und Glyphe (weitere Züge der Glyphe folgen) */
+static const uint8_t cache_glyph[PLOT_CELLS][GLYPH_COUNT] PROGMEM =
+{
+    { 0x00, 0x01, 0x02, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF },
+    { 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0xFF },
+    { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x0D },
+    { 0x0F, 0x10, 0x11, 0x12, 0x13, 0x14, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF },
+    { 0x15, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0xFF }
+};
+
+/* Glyphen mit Zug je Zelle (Bitmaske, Prüfung in plot.cpp) */
+#define CACHE_GLYPH_MASKS   { 0x0007, 0x03FF, 0x0400, 0x003F, 0x03FF }
+
+/* Wischbereiche: Zellen (Bitmaske) und Zug */
+static const uint8_t cache_erase_runs[CACHE_ERASE_RUNS][2] PROGMEM =
+{
+    { 0x02, 31 }, { 0x03, 32 }, { 0x10, 33 }, { 0x18, 34 }
+};
+
+static const CacheTrack cache_tracks[CACHE_TRACKS + 1] PROGMEM =
+{
+    {     0, { 157, 110 }, { 157, 110 } },    // Glyphe 0, Zelle 0
+    {   128, { 138, 119 }, { 154, 107 } },    // Glyphe 1, Zelle 0
+    {   208, { 138, 121 }, { 153, 105 } },    // Glyphe 2, Zelle 0
+    {   344, { 142,  92 }, { 142,  92 } },    // Glyphe 0, Zelle 1
+    {   472, { 127, 102 }, { 138,  89 } },    // Glyphe 1, Zelle 1
+    {   552, { 128, 103 }, { 136,  86 } },    // Glyphe 2, Zelle 1
+    {   688, { 129, 106 }, { 143, 102 } },    // Glyphe 3, Zelle 1
+    {   792, { 138,  89 }, { 129,  88 } },    // Glyphe 4, Zelle 1
+    {   920, { 146, 101 }, { 113,  95 } },    // Glyphe 5, Zelle 1
+    {  1048, { 130,  99 }, { 114,  96 } },    // Glyphe 6, Zelle 1
+    {  1209, { 121, 106 }, { 147,  98 } },    // Glyphe 7, Zelle 1
+    {  1305, { 131,  97 }, { 134, 100 } },    // Glyphe 8, Zelle 1
+    {  1437, { 132, 100 }, { 144,  95 } },    // Glyphe 9, Zelle 1
+    {  1517, { 116,  89 }, { 116,  89 } },    // Glyphe 10, Zelle 2
+    {  1518, { 127,  84 }, { 126,  84 } },    // Glyphe 10, Zelle 2
+    {  1519, { 121,  72 }, { 121,  72 } },    // Glyphe 0, Zelle 3
+    {  1647, { 111,  84 }, { 116,  68 } },    // Glyphe 1, Zelle 3
+    {  1727, { 112,  85 }, { 114,  66 } },    // Glyphe 2, Zelle 3
+    {  1863, { 114,  88 }, { 125,  82 } },    // Glyphe 3, Zelle 3
+    {  1967, { 116,  68 }, { 109,  69 } },    // Glyphe 4, Zelle 3
+    {  2095, { 127,  82 }, {  96,  79 } },    // Glyphe 5, Zelle 3
+    {  2223, {  99,  53 }, {  99,  53 } },    // Glyphe 0, Zelle 4
+    {  2351, {  93,  69 }, {  95,  50 } },    // Glyphe 1, Zelle 4
+    {  2431, {  94,  70 }, {  92,  47 } },    // Glyphe 2, Zelle 4
+    {  2567, {  96,  72 }, { 106,  64 } },    // Glyphe 3, Zelle 4
+    {  2671, {  95,  50 }, {  88,  53 } },    // Glyphe 4, Zelle 4
+    {  2799, { 107,  63 }, {  77,  67 } },    // Glyphe 5, Zelle 4
+    {  2927, {  94,  65 }, {  78,  67 } },    // Glyphe 6, Zelle 4
+    {  3088, {  90,  75 }, { 106,  59 } },    // Glyphe 7, Zelle 4
+    {  3184, {  95,  63 }, {  98,  65 } },    // Glyphe 8, Zelle 4
+    {  3316, {  96,  66 }, { 102,  55 } },    // Glyphe 9, Zelle 4
+    {  3396, { 104, 100 }, { 157, 100 } },    // Wischbereich 0x02
+    {  3608, { 104, 100 }, { 170, 118 } },    // Wischbereich 0x03
+    {  3987, {  69,  73 }, { 112,  58 } },    // Wischbereich 0x10
+    {  4244, {  69,  73 }, { 136,  79 } },    // Wischbereich 0x18
+    {  4677, { 0, 0 }, { 0, 0 } }
+};
+
+static const uint8_t cache_codes[2339] PROGMEM =
+{
+    0x15, 0x45, 0x15, 0x05, 0x15, 0x14, 0x15, 0x11, 0x51, 0x14, 0x15, 0x11,
+    0x15, 0x11, 0x61, 0x15, 0x11, 0x61, 0x15, 0x61, 0x16, 0x15, 0x16, 0x52,
+    0x55, 0x25, 0x52, 0x92, 0x55, 0x65, 0x56, 0x55, 0xA5, 0x55, 0xA5, 0x59,
+    0x55, 0x96, 0x95, 0x95, 0x99, 0x59, 0x95, 0x98, 0x68, 0x59, 0x99, 0x58,
+    0x99, 0x59, 0x85, 0x99, 0x58, 0x59, 0x59, 0x45, 0x95, 0x85, 0x58, 0x55,
+    0x54, 0x55, 0x45, 0x54, 0x10, 0x15, 0x05, 0x10, 0x51, 0x14, 0x10, 0x15,
+    0x55, 0x89, 0x55, 0x94, 0x59, 0x59, 0x58, 0x55, 0x95, 0x95, 0x95, 0x49,
+    0x59, 0x55, 0x95, 0x85, 0x95, 0x59, 0x59, 0x49, 0x55, 0x95, 0x95, 0x95,
+    0x95, 0x59, 0x58, 0x65, 0x89, 0x55, 0x95, 0x95, 0x41, 0x51, 0x64, 0x15,
+    0x15, 0x15, 0x51, 0x55, 0x05, 0x51, 0x45, 0x15, 0x41, 0x54, 0x55, 0x45,
+    0x14, 0x55, 0x45, 0x54, 0x55, 0x49, 0x45, 0x54, 0x59, 0x54, 0x59, 0x49,
+    0x55, 0x59, 0x54, 0x95, 0x99, 0x95, 0x99, 0x96, 0x99, 0x69, 0x96, 0x99,
+    0x69, 0x96, 0x99, 0x69, 0x5A, 0x99, 0x5A, 0x59, 0xA9, 0x69, 0x96, 0x99,
+    0x15, 0x45, 0x05, 0x54, 0x14, 0x55, 0x45, 0x14, 0x50, 0x55, 0x45, 0x14,
+    0x41, 0x54, 0x14, 0x55, 0x15, 0x41, 0x50, 0x55, 0x15, 0x01, 0x51, 0x51,
+    0x41, 0x15, 0x15, 0x21, 0x51, 0x15, 0x51, 0x16, 0x11, 0x61, 0x51, 0x61,
+    0x56, 0x51, 0x61, 0x65, 0x56, 0x15, 0x65, 0x56, 0x55, 0x65, 0x65, 0x59,
+    0x65, 0x59, 0x65, 0x95, 0x59, 0x96, 0x85, 0xA5, 0x94, 0xA8, 0x59, 0x59,
+    0x95, 0x99, 0x58, 0x95, 0x94, 0x99, 0x59, 0x49, 0x59, 0x45, 0x95, 0x85,
+    0x55, 0x49, 0x54, 0x55, 0x54, 0x54, 0x51, 0x54, 0x10, 0x51, 0x05, 0x10,
+    0x15, 0x10, 0x11, 0x50, 0x59, 0x55, 0x85, 0x95, 0x58, 0x55, 0x95, 0x58,
+    0x59, 0x55, 0x94, 0x59, 0x59, 0x55, 0x58, 0x59, 0x59, 0x54, 0x95, 0x55,
+    0x95, 0x95, 0x58, 0x55, 0x95, 0x59, 0x49, 0x55, 0x95, 0x59, 0x59, 0x55,
+    0x51, 0x51, 0x51, 0x51, 0x55, 0x15, 0x15, 0x41, 0x51, 0x55, 0x05, 0x51,
+    0x45, 0x15, 0x41, 0x54, 0x55, 0x41, 0x54, 0x55, 0x45, 0x54, 0x55, 0x45,
+    0x58, 0x55, 0x45, 0x95, 0x54, 0x95, 0x58, 0x55, 0x99, 0x59, 0x99, 0x95,
+    0xA9, 0x5A, 0x95, 0x9A, 0x95, 0xA9, 0x59, 0xA5, 0x9A, 0x95, 0xA9, 0x96,
+    0x99, 0xA5, 0x9A, 0x95, 0x54, 0x15, 0x05, 0x50, 0x54, 0x14, 0x15, 0x41,
+    0x54, 0x14, 0x14, 0x50, 0x55, 0x05, 0x14, 0x14, 0x11, 0x15, 0x01, 0x15,
+    0x14, 0x11, 0x41, 0x45, 0x04, 0x54, 0x54, 0x54, 0x94, 0x58, 0x59, 0x49,
+    0x59, 0x99, 0x95, 0xA9, 0x59, 0xA5, 0xA5, 0xA5, 0x65, 0xA5, 0x41, 0x40,
+    0x54, 0x14, 0x54, 0x45, 0x54, 0x58, 0x55, 0x85, 0x99, 0x59, 0x99, 0xA5,
+    0x99, 0xA5, 0xAA, 0x5A, 0x96, 0x5A, 0x56, 0x56, 0x52, 0x56, 0x51, 0x52,
+    0x55, 0x15, 0x15, 0x51, 0x55, 0x16, 0x15, 0x51, 0x55, 0x25, 0x51, 0x51,
+    0x55, 0x51, 0x65, 0x15, 0x15, 0x25, 0x55, 0x15, 0x15, 0x61, 0x55, 0x15,
+    0x25, 0x51, 0x55, 0x25, 0x51, 0x52, 0x55, 0x15, 0x99, 0x59, 0x99, 0x59,
+    0x95, 0x99, 0x96, 0x99, 0x99, 0x59, 0x95, 0xA8, 0xA5, 0x99, 0x99, 0x5A,
+    0x45, 0x05, 0x54, 0x15, 0x41, 0x54, 0x15, 0x45, 0x05, 0x51, 0x45, 0x05,
+    0x14, 0x51, 0x45, 0x41, 0x45, 0x55, 0x45, 0x54, 0x55, 0x54, 0x50, 0x55,
+    0x41, 0x54, 0x15, 0x41, 0x50, 0x55, 0x05, 0x15, 0x01, 0x51, 0x55, 0x05,
+    0x15, 0x15, 0x15, 0x51, 0x55, 0x15, 0x61, 0x55, 0x51, 0x65, 0x55, 0x65,
+    0x25, 0x65, 0x66, 0x96, 0x5A, 0x5A, 0x69, 0x5A, 0x51, 0x51, 0x55, 0x15,
+    0x15, 0x15, 0x52, 0x45, 0x16, 0x15, 0x51, 0x51, 0x55, 0x15, 0x15, 0x52,
+    0x41, 0x45, 0x05, 0x41, 0x45, 0x14, 0x14, 0x14, 0x41, 0x54, 0x15, 0x45,
+    0x15, 0x41, 0x54, 0x55, 0x45, 0x14, 0x55, 0x45, 0x54, 0x55, 0x49, 0x55,
+    0x45, 0x95, 0x45, 0x95, 0x59, 0x55, 0x94, 0xA5, 0x59, 0x59, 0x59, 0x56,
+    0x99, 0x55, 0xA9, 0x59, 0x65, 0x96, 0x95, 0x69, 0x56, 0x96, 0x55, 0xA5,
+    0x56, 0x55, 0x56, 0x55, 0x65, 0x56, 0x51, 0x56, 0x55, 0x15, 0x15, 0x65,
+    0x15, 0x15, 0x51, 0x51, 0x51, 0x51, 0x50, 0x55, 0x15, 0x15, 0x05, 0x51,
+    0x05, 0x51, 0x15, 0x14, 0x15, 0x15, 0x15, 0x51, 0x51, 0x51, 0x51, 0x51,
+    0x55, 0x05, 0x15, 0x11, 0x54, 0x55, 0x05, 0x54, 0x15, 0x45, 0x50, 0x55,
+    0x41, 0x54, 0x15, 0x45, 0x15, 0x45, 0x14, 0x50, 0x59, 0x59, 0x59, 0x59,
+    0x59, 0x59, 0x59, 0x59, 0x59, 0x59, 0x59, 0x59, 0x59, 0x59, 0x95, 0x95,
+    0x95, 0x95, 0xA5, 0x95, 0x95, 0x95, 0x95, 0x99, 0x68, 0x5A, 0x95, 0x59,
+    0x59, 0x96, 0x95, 0x99, 0x5A, 0x6A, 0x56, 0x56, 0x56, 0x16, 0x51, 0x25,
+    0x15, 0x21, 0x14, 0x11, 0x51, 0x14, 0x11, 0x41, 0x45, 0x05, 0x44, 0x54,
+    0x54, 0x58, 0x58, 0x55, 0x89, 0x59, 0x99, 0x59, 0x9A, 0x59, 0xA5, 0xA5,
+    0xA5, 0xA5, 0xA9, 0x5A, 0x99, 0x5A, 0x95, 0x99, 0x58, 0x95, 0x94, 0x58,
+    0x55, 0x44, 0x50, 0x50, 0x41, 0x41, 0x01, 0x41, 0x10, 0x15, 0x11, 0x51,
+    0x15, 0x25, 0x16, 0x56, 0x56, 0x56, 0x5A, 0x65, 0xA5, 0xA5, 0xA1, 0x65,
+    0x16, 0x15, 0x25, 0x11, 0x52, 0x10, 0x51, 0x15, 0x05, 0x10, 0x50, 0x54,
+    0x14, 0x45, 0x45, 0x45, 0x85, 0x49, 0x58, 0x55, 0x95, 0x99, 0x95, 0x99,
+    0x59, 0x59, 0x95, 0x99, 0x59, 0x5A, 0x99, 0x59, 0x95, 0x99, 0x5A, 0x99,
+    0x59, 0x96, 0x95, 0x10, 0x51, 0x45, 0x15, 0x10, 0x51, 0x55, 0x15, 0x15,
+    0x15, 0x15, 0x15, 0x25, 0x15, 0x25, 0x15, 0x61, 0x52, 0x56, 0x15, 0x25,
+    0x65, 0x25, 0x56, 0x52, 0x55, 0x65, 0x65, 0x56, 0x55, 0xA5, 0x56, 0x95,
+    0x59, 0x65, 0x95, 0x59, 0x68, 0x95, 0x59, 0x95, 0x95, 0x95, 0x94, 0x99,
+    0x59, 0x49, 0x59, 0x49, 0x59, 0x49, 0x58, 0x55, 0x94, 0x55, 0x49, 0x45,
+    0x54, 0x55, 0x54, 0x54, 0x14, 0x55, 0x05, 0x55, 0x11, 0x01, 0x11, 0x41,
+    0x11, 0x51, 0x01, 0x19, 0x54, 0x95, 0x49, 0x55, 0x94, 0x55, 0x94, 0x59,
+    0x55, 0x58, 0x55, 0x94, 0x59, 0x54, 0x59, 0x55, 0x49, 0x55, 0x95, 0x45,
+    0x95, 0x49, 0x55, 0x58, 0x64, 0x59, 0x55, 0x49, 0x55, 0x59, 0x45, 0x55,
+    0x52, 0x42, 0x51, 0x55, 0x15, 0x15, 0x05, 0x51, 0x51, 0x55, 0x14, 0x15,
+    0x50, 0x55, 0x05, 0x51, 0x45, 0x50, 0x55, 0x45, 0x54, 0x54, 0x55, 0x45,
+    0x55, 0x45, 0x45, 0x95, 0x45, 0x59, 0x45, 0x59, 0x94, 0x99, 0x59, 0x9A,
+    0x59, 0x95, 0xA9, 0x95, 0x99, 0x69, 0x95, 0xA9, 0x5A, 0x99, 0x5A, 0x95,
+    0x9A, 0x95, 0xA9, 0x91, 0x41, 0x41, 0x45, 0x14, 0x11, 0x45, 0x05, 0x05,
+    0x50, 0x05, 0x50, 0x51, 0x41, 0x41, 0x41, 0x51, 0x11, 0x51, 0x11, 0x51,
+    0x01, 0x50, 0x51, 0x40, 0x54, 0x54, 0x05, 0x85, 0x45, 0x49, 0x49, 0x59,
+    0x58, 0x99, 0x5A, 0x59, 0x99, 0xA5, 0xA5, 0xA6, 0x59, 0x60, 0x45, 0x05,
+    0x00, 0x54, 0x14, 0x45, 0x45, 0x45, 0x94, 0x58, 0x59, 0x59, 0x95, 0x9A,
+    0x9A, 0x5A, 0x9A, 0x5A, 0xA5, 0x69, 0x65, 0x66, 0x95, 0x25, 0x56, 0x15,
+    0x56, 0x15, 0x55, 0x16, 0x55, 0x15, 0x64, 0x25, 0x55, 0x16, 0x51, 0x56,
+    0x51, 0x55, 0x16, 0x55, 0x15, 0x65, 0x15, 0x61, 0x55, 0x25, 0x55, 0x15,
+    0x61, 0x55, 0x61, 0x55, 0x16, 0x51, 0x65, 0x19, 0x95, 0x98, 0x95, 0x99,
+    0x95, 0x99, 0x59, 0x99, 0x59, 0x95, 0x99, 0x95, 0x99, 0x95, 0x99, 0x55,
+    0x50, 0x51, 0x45, 0x05, 0x50, 0x51, 0x45, 0x14, 0x15, 0x41, 0x54, 0x15,
+    0x05, 0x41, 0x51, 0x44, 0x45, 0x54, 0x55, 0x41, 0x45, 0x51, 0x45, 0x50,
+    0x50, 0x50, 0x55, 0x14, 0x15, 0x41, 0x51, 0x41, 0x15, 0x51, 0x50, 0x51,
+    0x64, 0x51, 0x61, 0x55, 0x51, 0x65, 0x51, 0x56, 0x55, 0x56, 0x55, 0x65,
+    0x66, 0x56, 0xA5, 0xA5, 0xA5, 0xA6, 0x99, 0xA1, 0x51, 0x55, 0x15, 0x52,
+    0x42, 0x55, 0x15, 0x51, 0x55, 0x15, 0x52, 0x51, 0x51, 0x55, 0x16, 0x51,
+    0x40, 0x51, 0x45, 0x01, 0x54, 0x14, 0x15, 0x01, 0x41, 0x54, 0x15, 0x51,
+    0x51, 0x51, 0x52, 0x55, 0x15, 0x16, 0x15, 0x61, 0x52, 0x56, 0x16, 0x52,
+    0x56, 0x15, 0x61, 0x65, 0x62, 0x55, 0x65, 0x61, 0x65, 0x56, 0x5A, 0x55,
+    0x65, 0x59, 0x65, 0x5A, 0x59, 0x55, 0x95, 0x95, 0x95, 0x95, 0x95, 0x94,
+    0x95, 0x94, 0xA4, 0x95, 0x85, 0x94, 0x95, 0x85, 0x49, 0x54, 0x94, 0x54,
+    0x95, 0x45, 0x45, 0x45, 0x45, 0x54, 0x50, 0x54, 0x55, 0x05, 0x14, 0x51,
+    0x15, 0x11, 0x01, 0x15, 0x11, 0x11, 0x11, 0x55, 0x49, 0x55, 0x49, 0x54,
+    0x95, 0x49, 0x55, 0x45, 0x95, 0x49, 0x45, 0x55, 0x85, 0x55, 0x85, 0x55,
+    0x85, 0x45, 0x95, 0x45, 0x95, 0x45, 0x55, 0x85, 0x54, 0x59, 0x45, 0x55,
+    0x85, 0x55, 0x45, 0x95, 0x52, 0x55, 0x15, 0x15, 0x15, 0x51, 0x51, 0x51,
+    0x51, 0x55, 0x15, 0x05, 0x15, 0x51, 0x45, 0x14, 0x51, 0x54, 0x51, 0x45,
+    0x45, 0x19, 0x05, 0x45, 0x55, 0x85, 0x45, 0x55, 0x49, 0x54, 0x55, 0x85,
+    0x98, 0x59, 0x58, 0xA9, 0x58, 0xA5, 0x8A, 0x59, 0x95, 0x99, 0x59, 0x69,
+    0x99, 0x59, 0x5A, 0x99, 0x59, 0x95, 0x9A, 0x55, 0x05, 0x05, 0x05, 0x50,
+    0x14, 0x15, 0x05, 0x41, 0x50, 0x51, 0x41, 0x05, 0x51, 0x41, 0x41, 0x46,
+    0x11, 0x24, 0x21, 0x42, 0x01, 0x50, 0x15, 0x05, 0x05, 0x05, 0x44, 0x54,
+    0x54, 0x94, 0x45, 0x98, 0x59, 0x58, 0x95, 0x99, 0xA9, 0x59, 0xA5, 0xA6,
+    0x95, 0x64, 0x10, 0x41, 0x41, 0x40, 0x54, 0x14, 0x45, 0x45, 0x45, 0x85,
+    0x49, 0x59, 0x4A, 0x95, 0x99, 0x9A, 0x5A, 0x96, 0x9A, 0x65, 0xA5, 0x6A,
+    0x56, 0x56, 0x56, 0x51, 0x56, 0x55, 0x52, 0x55, 0x56, 0x15, 0x65, 0x52,
+    0x55, 0x56, 0x51, 0x56, 0x51, 0x56, 0x52, 0x55, 0x52, 0x55, 0x52, 0x55,
+    0x56, 0x16, 0x51, 0x56, 0x55, 0x16, 0x51, 0x65, 0x16, 0x55, 0x16, 0x55,
+    0x98, 0x95, 0x99, 0x85, 0x99, 0x49, 0x99, 0x59, 0x94, 0x95, 0x99, 0x59,
+    0x94, 0x99, 0x59, 0x91, 0x41, 0x54, 0x15, 0x05, 0x14, 0x51, 0x41, 0x55,
+    0x05, 0x14, 0x51, 0x50, 0x51, 0x45, 0x14, 0x14, 0x50, 0x55, 0x45, 0x05,
+    0x54, 0x14, 0x51, 0x41, 0x54, 0x15, 0x05, 0x50, 0x51, 0x51, 0x54, 0x15,
+    0x15, 0x15, 0x15, 0x51, 0x55, 0x52, 0x51, 0x56, 0x55, 0x1A, 0x15, 0x65,
+    0x55, 0x65, 0x65, 0x56, 0x69, 0x66, 0x96, 0x96, 0xA5, 0x9A, 0x5A, 0x95,
+    0x15, 0x52, 0x55, 0x15, 0x51, 0x56, 0x15, 0x51, 0x65, 0x15, 0x51, 0x65,
+    0x15, 0x15, 0x52, 0x55, 0x01, 0x50, 0x51, 0x05, 0x14, 0x14, 0x11, 0x55,
+    0x14, 0x51, 0x14, 0x51, 0x45, 0x15, 0x50, 0x54, 0x51, 0x45, 0x54, 0x15,
+    0x45, 0x54, 0x55, 0x45, 0x45, 0x58, 0x55, 0x45, 0x55, 0x85, 0x55, 0x94,
+    0x59, 0x55, 0x95, 0x59, 0x59, 0x59, 0x5A, 0x59, 0x55, 0xA5, 0x95, 0xA5,
+    0x96, 0x56, 0x95, 0xA5, 0x5A, 0x56, 0x56, 0x95, 0x65, 0x56, 0x56, 0x55,
+    0x56, 0x55, 0x61, 0x55, 0x25, 0x55, 0x15, 0x51, 0x64, 0x15, 0x61, 0x50,
+    0x60, 0x51, 0x55, 0x11, 0x51, 0x55, 0x15, 0x15, 0x15, 0x15, 0x15, 0x52,
+    0x51, 0x51, 0x51, 0x51, 0x52, 0x51, 0x51, 0x51, 0x05, 0x50, 0x51, 0x45,
+    0x15, 0x05, 0x15, 0x50, 0x55, 0x14, 0x15, 0x50, 0x51, 0x54, 0x15, 0x15,
+    0x58, 0x59, 0x94, 0x59, 0x59, 0x94, 0x95, 0x59, 0x58, 0x59, 0x59, 0x54,
+    0x95, 0x95, 0x86, 0x85, 0x95, 0x95, 0x59, 0x58, 0x55, 0x95, 0x95, 0x59,
+    0x58, 0x68, 0x59, 0x55, 0x95, 0x95, 0x59, 0x59, 0x6A, 0x96, 0x5A, 0x56,
+    0x65, 0x65, 0x65, 0x25, 0x12, 0x51, 0x52, 0x10, 0x60, 0x15, 0x10, 0x15,
+    0x05, 0x05, 0x41, 0x44, 0x54, 0x54, 0x58, 0x54, 0x94, 0x99, 0x58, 0x95,
+    0x99, 0x69, 0x99, 0x69, 0xA5, 0x9A, 0x95, 0xA9, 0x86, 0x94, 0x95, 0x94,
+    0x59, 0x45, 0x44, 0x50, 0x45, 0x05, 0x04, 0x10, 0x50, 0x10, 0x51, 0x14,
+    0x12, 0x51, 0x52, 0x51, 0x65, 0x65, 0x66, 0x56, 0x96, 0x69, 0x69, 0x69,
+    0xA5, 0xA9, 0x56, 0x56, 0x52, 0x56, 0x16, 0x15, 0x12, 0x51, 0x11, 0x15,
+    0x01, 0x50, 0x15, 0x05, 0x05, 0x41, 0x44, 0x55, 0x45, 0x84, 0x58, 0x55,
+    0x98, 0x55, 0x8A, 0x49, 0x59, 0x58, 0x59, 0x95, 0x94, 0x95, 0x95, 0x85,
+    0x95, 0x95, 0x99, 0x55, 0x98, 0x59, 0x95, 0x69, 0x6A, 0xA6, 0xA9, 0x6A,
+    0xA6, 0xA6, 0x59, 0x55, 0x59, 0x89, 0x89, 0x94, 0x55, 0x50, 0x50, 0x40,
+    0x04, 0x01, 0x40, 0x00, 0x54, 0x15, 0x49, 0x59, 0x89, 0x49, 0x98, 0x55,
+    0x55, 0xA6, 0x9A, 0xA6, 0xAA, 0x6A, 0xAA, 0x5A, 0x65, 0x55, 0x95, 0x89,
+    0x98, 0x99, 0x54, 0xA5, 0x05, 0x04, 0x00, 0x04, 0x00, 0x00, 0x01, 0x40,
+    0x55, 0x59, 0x58, 0x95, 0x98, 0x59, 0x55, 0x59, 0x69, 0xAA, 0xAA, 0x6A,
+    0xAA, 0xAA, 0xA6, 0x5A, 0x55, 0x55, 0x89, 0xF2, 0x0F, 0x95, 0x99, 0x55,
+    0x45, 0x50, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x05, 0x55, 0x55, 0x99,
+    0x89, 0x95, 0x59, 0x55, 0x5A, 0x9F, 0x12, 0xFA, 0xAA, 0xF2, 0x1F, 0xAA,
+    0xAA, 0xAA, 0x6A, 0x55, 0x95, 0x69, 0x6A, 0xAA, 0x6A, 0x6A, 0x9F, 0x02,
+    0xFA, 0x96, 0xA6, 0xA6, 0xAA, 0x66, 0xAF, 0x02, 0xF9, 0xF0, 0x2F, 0x6A,
+    0x66, 0x96, 0x55, 0x49, 0x98, 0x89, 0x85, 0x55, 0x54, 0x44, 0x04, 0x04,
+    0x04, 0x04, 0x04, 0x04, 0x00, 0x40, 0x40, 0x04, 0x01, 0x04, 0x00, 0x41,
+    0x41, 0x54, 0x95, 0x98, 0x94, 0x99, 0x85, 0x55, 0x5A, 0x69, 0xAA, 0x6A,
+    0xAA, 0x6A, 0xA6, 0xAA, 0xA6, 0xAA, 0x6A, 0x6A, 0x6A, 0x6A, 0x6A, 0x65,
+    0xA5, 0x55, 0x59, 0x5F, 0x20, 0xF8, 0x99, 0x49, 0x59, 0x15, 0x45, 0x04,
+    0xFF, 0xEF, 0x40, 0x40, 0x40, 0x5F, 0xFE, 0xF0, 0x40, 0x01, 0xF0, 0xEF,
+    0x1F, 0xFE, 0xF0, 0x50, 0x0F, 0xFE, 0xF1, 0xFF, 0xEF, 0x14, 0x00, 0x55,
+    0x59, 0x58, 0x95, 0x98, 0x59, 0x55, 0x59, 0x69, 0xAA, 0xAA, 0xF0, 0x2F,
+    0xF2, 0x0F, 0xA6, 0xAF, 0x12, 0xFA, 0x6A, 0xAA, 0xA6, 0xAA, 0x6A, 0xA6,
+    0xA6, 0xAA, 0x65, 0xA5, 0x55, 0x59, 0x99, 0x99, 0x98, 0x68, 0x55, 0x50,
+    0x54, 0x00, 0x44, 0x00, 0x40, 0x00, 0x04, 0x00, 0xFF, 0xEF, 0x00, 0x00,
+    0x00, 0x4F, 0xEF, 0xF0, 0x00, 0x04, 0x05, 0x55, 0x55, 0x99, 0x89, 0x95,
+    0x59, 0x55, 0x5A, 0xAA, 0xAA, 0xF2, 0x1F, 0xAA, 0xAF, 0x12, 0xFA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0x6A, 0xAA, 0xF0, 0x2F, 0x9A, 0x6A, 0xF0, 0x2F, 0x96,
+    0xA5, 0x55, 0x69, 0x9A, 0xA9, 0xA9, 0xAA, 0xF2, 0x0F, 0xAA, 0x96, 0x95,
+    0x55, 0x94, 0x98, 0x89, 0x45, 0x91, 0x54, 0x10, 0x10, 0x01, 0x0F, 0xEF,
+    0xF4, 0xFE, 0x0F, 0x01, 0x05, 0x15, 0x94, 0x59, 0x84, 0x88, 0x59, 0x45,
+    0x55, 0xA9, 0xA9, 0xAA, 0xA9, 0xF2, 0x1F, 0xAA, 0x9A, 0x69, 0x55, 0x59,
+    0x54, 0x98, 0x94, 0x94, 0x55, 0x55, 0x05, 0x0F, 0xEF, 0xF0, 0x01, 0x00,
+    0x0F, 0xEF, 0xF1, 0x01, 0x45, 0x55, 0x45, 0x58, 0x48, 0x58, 0x54, 0x56,
+    0x95, 0xAA, 0xF2, 0x0F, 0xAA, 0xAA, 0xAA, 0xF2, 0x1F, 0xA9, 0xA6, 0x95,
+    0x55, 0x49, 0x49, 0x49, 0x54, 0x95, 0x51, 0x05, 0xFF, 0xEF, 0xFE, 0xFF,
+    0x00, 0x1F, 0xFE, 0xFF, 0xEF, 0xF1, 0xFF, 0xEF, 0xFE, 0x0F, 0x04, 0x10,
+    0x55, 0x59, 0x45, 0x84, 0x49, 0x45, 0x55, 0x5A, 0xAA, 0xAF, 0x21, 0xFA,
+    0xAF, 0x21, 0xFA, 0xAF, 0x21, 0xFF, 0x12, 0xFA, 0xA9, 0x65, 0x56, 0x99,
+    0xAA, 0x9A, 0x9F, 0x21, 0xFA, 0x9A, 0xA9, 0xAA, 0xA9, 0xAA, 0xA9, 0xAA,
+    0x9A, 0xAA, 0xA6, 0x9A, 0x55, 0x56, 0x89, 0x58, 0x89, 0x85, 0x55, 0x50,
+    0x50, 0x00, 0x01, 0x00, 0x00, 0x50, 0xFE, 0xFF, 0x01, 0x00, 0x01, 0x00,
+    0x01, 0x00, 0x1F, 0xEF, 0xF0, 0x10, 0x51, 0x59, 0x45, 0x98, 0x48, 0x85,
+    0x94, 0x55, 0x5A, 0x9A, 0xA9, 0xAA, 0xF2, 0x0F, 0xAA, 0xAA, 0xA9, 0xAA,
+    0xA9, 0xAA, 0xF2, 0x1F, 0x6F, 0x21, 0xF6, 0xAA, 0x9A, 0xAA, 0x96, 0x59,
+    0x55, 0x59, 0x89, 0x49, 0x94, 0x55, 0x55, 0x41, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x1F, 0xEE, 0xF1, 0xFF, 0xEF, 0x10, 0x00, 0x00, 0xFE, 0x0F, 0x00,
+    0x00, 0x0F, 0xE0, 0xF0, 0x50, 0x55, 0x54, 0x55, 0x84, 0x85, 0x85, 0x45,
+    0x69, 0x5A, 0xAF, 0x20, 0xFA, 0xAA, 0xAA, 0xF2, 0x1F, 0xAA, 0xAA, 0xF2,
+    0x1F, 0xAA, 0xAA, 0xF2, 0x1F, 0xAA, 0xAA, 0xAA, 0xAF, 0x21, 0xFA, 0xA6,
+    0x95, 0x55, 0x95, 0x59, 0x98, 0x95, 0x94, 0x55, 0x50, 0x01, 0xFF, 0xEF,
+    0x1F, 0xEE, 0xF0, 0x00, 0x0F, 0xEF, 0xF0, 0xFF, 0xEF, 0x1F, 0xEE, 0xF0,
+    0x0F, 0xEF, 0xF0, 0x00, 0x0F, 0xEF, 0xF0, 0x0F, 0xEF, 0xF0, 0x00, 0xFE,
+    0xFF, 0x41, 0x05, 0x55, 0x94, 0x58, 0x44, 0x94, 0x55, 0x55, 0xAA, 0xAA,
+    0xF2, 0x1F, 0xAA, 0xF2, 0x1F, 0xAF, 0x22, 0xFA, 0xAF, 0x21, 0xFA, 0xF1,
+    0x2F, 0xF2, 0x1F, 0xAF, 0x21, 0xFF, 0x12, 0xFA, 0xF2, 0x1F, 0xAF, 0x21,
+    0xFF, 0x12, 0xFA, 0xAF, 0x21, 0xFF, 0x12, 0xFA, 0xAA, 0x96, 0x90
+};
+
+#endif // PLOTCACHE_H
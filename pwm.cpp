@@ -1,156 +1,261 @@
 #include "pwm.h"
 #include <avr/interrupt.h>
+#include <util/atomic.h>
+#include "isrstat.h"
+#include "trace.h"
 
-// Definition der globalen Variablen:
-uint16_t pwm_timing[PWM_CHANNELS+1];
-uint16_t pwm_timing_tmp[PWM_CHANNELS+1];
+// Anschlüsse der Kanäle (Port-Index << 3 | Bit)
+static constexpr uint8_t pwm_pins[PWM_CHANNELS] = PWM_PINS;
+
+// Ausgänge eines Ports laut PWM_PINS (nur zur Prüfung beim Übersetzen)
+static constexpr uint8_t pwm_port_mask(uint8_t port) {
+    uint8_t mask = 0;
+
+    for (uint8_t i = 0; i < PWM_CHANNELS; i++) {
+        if ((pwm_pins[i] >> 3) == port)
+            mask |= 1 << (pwm_pins[i] & 7);
+    }
+    return mask;
+}
 
-uint8_t pwm_mask[PWM_CHANNELS+1];
-uint8_t pwm_mask_tmp[PWM_CHANNELS+1];
+static_assert(pwm_port_mask(PWM_PB) == PWM_MASK_B, "PWM_MASK_B passt nicht zu PWM_PINS");
+static_assert(pwm_port_mask(PWM_PC) == PWM_MASK_C, "PWM_MASK_C passt nicht zu PWM_PINS");
+static_assert(pwm_port_mask(PWM_PD) == PWM_MASK_D, "PWM_MASK_D passt nicht zu PWM_PINS");
 
+// Definition der globalen Variablen:
 uint8_t pwm_setting[PWM_CHANNELS];
-uint8_t pwm_setting_tmp[PWM_CHANNELS+1];
 
-volatile uint8_t pwm_cnt_max = 1;
-volatile uint8_t pwm_sync;
+// Kanäle aufsteigend nach Einstellung; bleibt zwischen den Aufrufen erhalten
+static uint8_t pwm_order[PWM_CHANNELS];
+
+volatile uint16_t pwm_frames;
+
+// Übergabe an die ISR ohne Sperren: drei Flankensätze (aktiv in der ISR,
+// bereitgestellt, in Arbeit). Der Schreiber füllt einen Satz, der weder
+// aktiv noch bereitgestellt ist, setzt dann pwm_ready und zählt pwm_seq
+// weiter. Die ISR setzt bei neuer Version pwm_active = pwm_ready; der Satz
+// in Arbeit wird dadurch nie aktiv. Alle Zugriffe sind einzelne Bytes.
+static PwmSchedule pwm_sched[3];
+static volatile uint8_t pwm_seq;        // Version des bereitgestellten Satzes
+static volatile uint8_t pwm_ready;      // zuletzt veröffentlichter Satz
+static volatile uint8_t pwm_active;     // Satz des laufenden Zyklus (ISR)
+static uint8_t pwm_seen;                // von der ISR übernommene Version
+
+static uint8_t pwm_cnt;                 // Zähler für PWM-Flanken (ISR)
+static volatile uint8_t pwm_running;    // Timer1 läuft (mindestens ein Kanal aktiv)
 
-uint16_t *isr_ptr_time  = pwm_timing;
-uint16_t *main_ptr_time = pwm_timing_tmp;
-uint8_t  *isr_ptr_mask  = pwm_mask;
-uint8_t  *main_ptr_mask = pwm_mask_tmp;
+static void pwm_start(void);
+static void pwm_stop(void);
 
-// Interner Hilfsfunktionsprototyp – tauscht Zeiger zwischen ISR und Hauptprogramm
-static inline void tausche_zeiger(void) {
-    uint16_t *tmp_ptr16;
-    uint8_t  *tmp_ptr8;
+// Aufruf beim Warten auf das Zyklusende; der Simulator (tools/plotsim)
+// lässt hier Timer1 weiterlaufen
+#ifdef PWM_WAIT_HOOK
+void PWM_WAIT_HOOK(void);
+#else
+#define PWM_WAIT_HOOK()
+#endif
 
-    tmp_ptr16 = isr_ptr_time;
-    isr_ptr_time = main_ptr_time;
-    main_ptr_time = tmp_ptr16;
+// Ausgänge aller Kanäle konfigurieren (Ports ohne PWM-Kanal bleiben unverändert)
+void pwm_init(void) {
+    uint8_t i;
 
-    tmp_ptr8 = isr_ptr_mask;
-    isr_ptr_mask = main_ptr_mask;
-    main_ptr_mask = tmp_ptr8;
+    DDRB |= PWM_MASK_B;
+    DDRC |= PWM_MASK_C;
+    DDRD |= PWM_MASK_D;
+    for(i = 0; i < PWM_CHANNELS; i++)
+        pwm_order[i] = i;
 }
 
 // PWM-Update-Funktion: Berechnet aus den aktuellen Einstellungen die neuen PWM-Zeit- und Maskenwerte
 void pwm_update(void) {
-    uint8_t i, j, k;
-    uint8_t m1, m2, tmp_mask;
-    uint8_t min, tmp_set;
-
-    // Initiale Maske berechnen und PWM-Werte kopieren:
-    m1 = 1;
-    m2 = 0;
-    for(i = 1; i <= PWM_CHANNELS; i++) {
-        main_ptr_mask[i] = ~m1;               // Maske zum Löschen der PWM-Ausgänge
-        pwm_setting_tmp[i] = pwm_setting[i-1];
-        if (pwm_setting_tmp[i] != 0) {
-            m2 |= m1;                       // Maske zum Setzen der Ausgänge
-        }
-        m1 <<= 1;
-    }
-    main_ptr_mask[0] = m2;
-
-    // Sortieren der PWM-Werte (z. B. mit einem einfachen Auswahlverfahren):
-    for(i = 1; i <= PWM_CHANNELS; i++) {
-        min = PWM_STEPS - 1;
-        k = i;
-        for(j = i; j <= PWM_CHANNELS; j++) {
-            if (pwm_setting_tmp[j] < min) {
-                k = j;
-                min = pwm_setting_tmp[j];
-            }
-        }
-        if (k != i) {
-            tmp_set = pwm_setting_tmp[k];
-            pwm_setting_tmp[k] = pwm_setting_tmp[i];
-            pwm_setting_tmp[i] = tmp_set;
-            tmp_mask = main_ptr_mask[k];
-            main_ptr_mask[k] = main_ptr_mask[i];
-            main_ptr_mask[i] = tmp_mask;
-        }
-    }
+    PwmSchedule *sc;
+    PwmEdge *e;
+    uint8_t i, j, k, p, w;
+    uint8_t ch, pin, val, prev;
 
-    // Vereinigen gleicher PWM-Werte und Entfernen von Nullen:
-    k = PWM_CHANNELS;
-    i = 1;
-    while(k > i) {
-        while(((pwm_setting_tmp[i] == pwm_setting_tmp[i+1]) || (pwm_setting_tmp[i] == 0)) && (k > i)) {
-            if (pwm_setting_tmp[i] != 0)
-                main_ptr_mask[i+1] &= main_ptr_mask[i];
-            for(j = i; j < k; j++) {
-                pwm_setting_tmp[j] = pwm_setting_tmp[j+1];
-                main_ptr_mask[j] = main_ptr_mask[j+1];
-            }
-            k--;
-        }
-        i++;
+    // Satz in Arbeit: freien Puffer wählen (weder aktiv noch bereitgestellt)
+    for(w = 0; w == pwm_active || w == pwm_ready; w++);
+    sc = &pwm_sched[w];
+    e = sc->edge;
+
+    // Sortieren der Kanäle nach ihrem PWM-Wert durch Einfügen in die Reihenfolge
+    // des letzten Aufrufs. Die Werte ändern sich von Zyklus zu Zyklus nur wenig,
+    // die Reihenfolge ist daher meist schon sortiert (Aufwand ~ Kanalzahl):
+    for(i = 1; i < PWM_CHANNELS; i++) {
+        ch = pwm_order[i];
+        val = pwm_setting[ch];
+        for(j = i; j > 0 && pwm_setting[pwm_order[j-1]] > val; j--)
+            pwm_order[j] = pwm_order[j-1];
+        pwm_order[j] = ch;
     }
-    if (pwm_setting_tmp[i] == 0) k--;
 
-    // Berechnung der Zeitdifferenzen für die PWM-Ausgabe:
-    if (k == 0) { // Sonderfall: alle Kanäle auf 0
-        main_ptr_time[0] = (uint16_t)T_PWM * PWM_STEPS / 2;
-        main_ptr_time[1] = (uint16_t)T_PWM * PWM_STEPS / 2;
-        k = 1;
-    } else {
-        i = k;
-        main_ptr_time[i] = (uint16_t)T_PWM * (PWM_STEPS - pwm_setting_tmp[i]);
-        tmp_set = pwm_setting_tmp[i];
-        i--;
-        for(; i > 0; i--) {
-            main_ptr_time[i] = (uint16_t)T_PWM * (tmp_set - pwm_setting_tmp[i]);
-            tmp_set = pwm_setting_tmp[i];
+    // Flanken in einem Durchlauf bilden: gleiche PWM-Werte vereinigen, Nullen
+    // auslassen. Flanke 0 enthält die Masken zum Setzen, alle weiteren die
+    // Masken zum Löschen der Ausgänge je Port:
+    for(p = 0; p < PWM_PORTS; p++)
+        e[0].mask[p] = 0;
+    k = 0;
+    prev = 0;
+    for(i = 0; i < PWM_CHANNELS; i++) {
+        ch = pwm_order[i];
+        val = pwm_setting[ch];
+        if (val == 0)
+            continue;
+        if (val != prev) {
+            e[k].time = (uint16_t)T_PWM * (val - prev);
+            k++;
+            for(p = 0; p < PWM_PORTS; p++)
+                e[k].mask[p] = 0xFF;
+            prev = val;
         }
-        main_ptr_time[0] = (uint16_t)T_PWM * tmp_set;
+        pin = pwm_pins[ch];
+        e[0].mask[pin >> 3] |= 1 << (pin & 7);
+        e[k].mask[pin >> 3] &= ~(1 << (pin & 7));
     }
 
-    // Warten, bis der ISR-Sync-Flag gesetzt wurde:
-    pwm_sync = 0;
-    while(pwm_sync == 0);
+    // Zeit nach der letzten Flanke bis zum Ende des Zyklus:
+    if (k != 0)
+        e[k].time = (uint16_t)T_PWM * (PWM_STEPS - prev);
+    sc->count = k;
+
+    // Veröffentlichen; bei laufendem Timer übernimmt die ISR den Satz am
+    // Ende des laufenden Zyklus (alle Kanäle aus: sie hält Timer1 dann an)
+    pwm_ready = w;
+    pwm_seq++;
+    TRACE_EVENT(TRACE_PWM, k, pwm_seq);
 
-    cli();
-    tausche_zeiger();
-    pwm_cnt_max = k;
-    sei();
+    // Aus dem Leerlauf: mit Flanke 0 neu beginnen
+    if (k != 0 && !pwm_running)
+        pwm_start();
 }
 
 // Setzt die PWM-Werte für alle Kanäle und aktualisiert die PWM-Ausgabe
-void set_pwm(uint8_t val1, uint8_t val2, uint8_t val3) {
-    pwm_setting[0] = val1;
-    pwm_setting[1] = val2;
-    pwm_setting[2] = val3;
+void set_pwm(const uint8_t *values) {
+    uint8_t i;
+
+    for(i = 0; i < PWM_CHANNELS; i++)
+        pwm_setting[i] = values[i];
+    pwm_update();
+}
+
+// Schaltet alle Kanäle ab (Servos stromlos)
+void pwm_off(void) {
+    uint8_t i;
+
+    for(i = 0; i < PWM_CHANNELS; i++)
+        pwm_setting[i] = 0;
     pwm_update();
 }
 
+// Liefert den PWM-Zykluszähler (Zeitbasis für das Servo-Bewegungsmodell)
+uint16_t pwm_get_frames(void) {
+    uint16_t frames;
+
+    // Ohne Interruptsperre: lesen, bis zwei Werte übereinstimmen
+    do {
+        frames = pwm_frames;
+    } while (frames != pwm_frames);
+    return frames;
+}
+
+// Wartet bis zum Ende des laufenden PWM-Zyklus (im Leerlauf nicht)
+void pwm_wait_frame(void) {
+    uint16_t frames = pwm_get_frames();
+
+    if (!pwm_running)
+        return;
+
+    while (pwm_get_frames() == frames)
+        PWM_WAIT_HOOK();
+}
+
+// Übernimmt den jüngsten vollständig veröffentlichten Satz (aus der ISR am
+// Zyklusende oder bei angehaltenem Timer)
+static inline void pwm_fetch(void) {
+    if (pwm_seq != pwm_seen) {
+        pwm_active = pwm_ready;
+        pwm_seen = pwm_seq;
+    }
+}
+
 // Timer1 Compare A Interrupt – generiert die PWM-Ausgabe:
 ISR(TIMER1_COMPA_vect) {
-    static uint8_t pwm_cnt = 0; // Zähler für PWM-Kanäle
-    uint8_t tmp;
+    ISR_STATS_ENTER();
+    const PwmSchedule *sc = &pwm_sched[pwm_active];
+    const PwmEdge *e = &sc->edge[pwm_cnt];
 
-    OCR1A += isr_ptr_time[pwm_cnt];
-    tmp = isr_ptr_mask[pwm_cnt];
+    ISR_STATS_LATENCY(ISR_STAT_TIMER1A, OCR1A);
+    OCR1A += e->time;
 
     if (pwm_cnt == 0) {
-        PWM_PORT = tmp; // Setzt die Ausgänge zu Beginn des PWM-Zyklus
+        // Setzt die Ausgänge zu Beginn des PWM-Zyklus (übrige Bits der Ports bleiben erhalten)
+#if PWM_MASK_B
+        PORTB |= e->mask[PWM_PB];
+#endif
+#if PWM_MASK_C
+        PORTC |= e->mask[PWM_PC];
+#endif
+#if PWM_MASK_D
+        PORTD |= e->mask[PWM_PD];
+#endif
         pwm_cnt++;
     } else {
-        PWM_PORT &= tmp; // Löscht die entsprechenden Ausgänge
-        if (pwm_cnt == pwm_cnt_max) {
-            pwm_sync = 1; // Update möglich, Zyklus beendet
+        // Löscht die Ausgänge aller Kanäle dieser Flanke
+#if PWM_MASK_B
+        PORTB &= e->mask[PWM_PB];
+#endif
+#if PWM_MASK_C
+        PORTC &= e->mask[PWM_PC];
+#endif
+#if PWM_MASK_D
+        PORTD &= e->mask[PWM_PD];
+#endif
+        if (pwm_cnt == sc->count) {
+            // Zyklus beendet: neuen Satz für den nächsten Zyklus übernehmen
+            pwm_frames++;
             pwm_cnt = 0;
+            pwm_fetch();
+            if (pwm_sched[pwm_active].count == 0)
+                pwm_stop(); // alle Kanäle aus: Timer1 anhalten
         } else {
             pwm_cnt++;
         }
     }
-    // Hinweis: Falls im ursprünglichen Code eine Variable "t" verwendet wurde,
-    // entferne sie, falls sie nicht deklariert ist oder definiere sie korrekt.
+    ISR_STATS_EXIT(ISR_STAT_TIMER1A);
 }
 
-// Initialisiert Timer1 für PWM (z. B. im CTC-Modus mit Prescaler 8)
-void init_TCNT1_PWM(void) {
-    TCCR1B = 2;              // Prescaler 8
-    TIFR |= (1 << OCF1A);      // Löscht das Compare-Flag
+// Startet Timer1 mit einem neuen Zyklus: Flanke 0 folgt nach einem PWM-Schritt
+static void pwm_start(void) {
+    pwm_fetch();
+    pwm_cnt = 0;
+    TCCR1A = 0;
+#ifdef PWM_TIMER1_SHARED
+    // Timer1 läuft für andere Aufgaben weiter; andere ISRs greifen auf
+    // Timer1 zu, daher den 16-Bit-Zugriff (TEMP-Register) schützen
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        OCR1A = TCNT1 + T_PWM;
+    }
+#else
+    TCNT1 = 0;
+    OCR1A = T_PWM;
+#endif
+    TIFR = (1 << OCF1A);       // Löscht nur das Compare-Flag
     TIMSK |= (1 << OCIE1A);    // Enable Timer1 Compare A Interrupt
+    TCCR1B = 2;                // Prescaler 8
+    pwm_running = 1;
+}
+
+// Hält Timer1 an und sperrt seinen Interrupt; alle Ausgänge aus (aus der ISR)
+static void pwm_stop(void) {
+    TIMSK &= ~(1 << OCIE1A);
+#ifndef PWM_TIMER1_SHARED
+    TCCR1B = 0;
+#elif !defined(ISR_STATS)
+    if (!(TIMSK & (1 << OCIE1B)))
+        TCCR1B = 0;            // DCF-Abtastung ruht ebenfalls: Timer1 ganz aus
+#endif
+    PORTB &= ~PWM_MASK_B;
+    PORTC &= ~PWM_MASK_C;
+    PORTD &= ~PWM_MASK_D;
+    pwm_running = 0;
 }
@@ -9,20 +9,27 @@
 #define F_PWM         50L               // PWM-Frequenz in Hz (20ms Intervall)
 #define PWM_PRESCALER 8                 // Vorteiler fr den Timer
 #define PWM_STEPS     256               // PWM-Schritte pro Zyklus (1..256)
-#define PWM_PORT      PORTD             // Port fr PWM
-#define PWM_DDR       DDRD              // Datenrichtungsregister fr PWM
 #define PWM_CHANNELS  3                 // Anzahl der PWM-Kanle
-#define PWM_KEYS      ((1 << 5) | (1 << 6) | (1 << 7))
+
+// Anschluss der Kanle: Port-Index und Bit, Reihenfolge = Kanalnummer
+#define PWM_PB        0
+#define PWM_PC        1
+#define PWM_PD        2
+#define PWM_PORTS     3
+#define PWM_PIN(port, bit)  (((port) << 3) | (bit))
+#define PWM_PINS      { PWM_PIN(PWM_PD, 5), PWM_PIN(PWM_PD, 6), PWM_PIN(PWM_PD, 7) }
+
+// Ausgnge je Port (mssen zu PWM_PINS passen, wird in pwm.cpp geprft).
+// Ports ohne PWM-Kanal werden in der ISR nicht angefasst.
+#define PWM_MASK_B    0
+#define PWM_MASK_C    0
+#define PWM_MASK_D    ((1 << 5) | (1 << 6) | (1 << 7))
 
 #define MIN_PULSE_WIDTH      500        // krzester Puls
 #define MAX_PULSE_WIDTH     2500        // lngster Puls
 #define DEFAULT_PULSE_WIDTH 1500        // Standard-Puls
 #define REFRESH_INTERVAL   20000        // Mindest-Refreshzeit
 
-#define SMALL_DELAY _delay_ms(30.0)
-#define BIG_DELAY   _delay_ms(50.0)
-#define BIGGER_DELAY _delay_ms(200.0)
-
 #ifndef F_CPU
   //#define F_CPU 4000000L  // Falls nicht extern definiert
 #endif
@@ -34,32 +41,50 @@
 #error T_PWM zu klein, F_CPU muss vergrert werden oder F_PWM bzw. PWM_STEPS verkleinert werden
 #endif
 
+// Umrechnung Pulsbreite [s] -> PWM-Schritte (gerundet)
+#define PWM_US_TO_STEPS(us) ((uint8_t)((((uint32_t)(us)*(F_CPU/1000L))/1000L + (T_PWM*PWM_PRESCALER)/2) / (T_PWM*PWM_PRESCALER)))
+
 #if ((T_PWM*PWM_STEPS) > 65535)
 #error Periodendauer der PWM zu gro! F_PWM oder PWM_PRESCALER erhhen.
 #endif
 
-// Globale Variablen  extern deklariert
-extern uint16_t pwm_timing[PWM_CHANNELS+1];         // Zeitdifferenzen der PWM-Werte
-extern uint16_t pwm_timing_tmp[PWM_CHANNELS+1];
+// Timer1 luft frei weiter, wenn er neben der PWM weitere Aufgaben hat
+// (ISR-Statistik, DCF-Abtastung ber Compare B); die PWM stellt dann nur OCR1A
+#if defined(ISR_STATS) || defined(DCF_SAMPLE_TIMER1)
+#define PWM_TIMER1_SHARED
+#endif
 
-extern uint8_t  pwm_mask[PWM_CHANNELS+1];           // Bitmasken fr PWM-Ausgnge (zum Lschen)
-extern uint8_t  pwm_mask_tmp[PWM_CHANNELS+1];
+// Eine Flanke der PWM-Ausgabe: Lschmasken je Port (bei Flanke 0: Setzmasken)
+// und Zeit bis zur nchsten Flanke
+typedef struct
+{
+    uint16_t time;
+    uint8_t  mask[PWM_PORTS];
+} PwmEdge;
 
-extern uint8_t  pwm_setting[PWM_CHANNELS];          // PWM-Einstellungen pro Kanal
-extern uint8_t  pwm_setting_tmp[PWM_CHANNELS+1];    // Sortierte PWM-Werte
+// Vollstndiger Flankensatz eines Zyklus (count = 0: alle Kanle aus)
+typedef struct
+{
+    uint8_t  count;                     // Anzahl Lschflanken
+    PwmEdge  edge[PWM_CHANNELS+1];
+} PwmSchedule;
 
-extern volatile uint8_t pwm_cnt_max;              // Zhlergrenze (Initialwert 1 ist wichtig!)
-extern volatile uint8_t pwm_sync;                   // Flag, dass ein Update mglich ist
+// Globale Variablen  extern deklariert
+extern uint8_t  pwm_setting[PWM_CHANNELS];          // PWM-Einstellungen pro Kanal
 
-// Pointer fr wechselseitigen Zugriff (zwischen ISR und Hauptprogramm)
-extern uint16_t *isr_ptr_time;
-extern uint16_t *main_ptr_time;
-extern uint8_t  *isr_ptr_mask;
-extern uint8_t  *main_ptr_mask;
+extern volatile uint16_t pwm_frames;                // Anzahl abgeschlossener PWM-Zyklen (20ms)
 
 // Funktionsprototypen
-void init_TCNT1_PWM(void);
+// pwm_update() verffentlicht die Einstellungen ohne zu warten und ohne
+// Interrupts zu sperren; die ISR bernimmt den jngsten vollstndigen Satz
+// zu Beginn des nchsten Zyklus. Es darf nur ein Schreiber zur Zeit aktiv
+// sein (Hauptprogramm oder eine ISR). Timer1 startet mit dem ersten aktiven
+// Kanal und hlt an, sobald alle Kanle 0 sind (kein Interrupt im Leerlauf).
+void pwm_init(void);
 void pwm_update(void);
-void set_pwm(uint8_t val1, uint8_t val2, uint8_t val3);
+void set_pwm(const uint8_t *values);
+void pwm_off(void);
+uint16_t pwm_get_frames(void);
+void pwm_wait_frame(void);
 
 #endif // PWM_H
@@ -0,0 +1,112 @@
+#include "servo.h"
+#include "calib.h"
+#include "stats.h"
+
+/* Bewegungsmodell aller Servos */
+static Servo servos[SERVO_COUNT];
+
+uint32_t servo_travel;
+
+void servo_init(void)
+{
+    uint8_t ch;
+    uint16_t now = pwm_get_frames();
+
+    for (ch = 0; ch < SERVO_COUNT; ch++)
+    {
+        servos[ch].angle = 90;          // unbekannte Lage: Mitte annehmen
+        servos[ch].from = 90;
+        servos[ch].start = now;
+        servos[ch].ready = now;
+        servo_config(ch, SERVO_TRAVEL_US_PER_DEG, SERVO_SETTLE_US_PER_DEG, SERVO_SETTLE_US);
+    }
+}
+
+void servo_config(uint8_t ch, uint16_t travel_us, uint16_t settle_us, uint16_t settle_base_us)
+{
+    servos[ch].travel_us = travel_us;
+    servos[ch].settle_us = settle_us;
+    servos[ch].settle_base_us = settle_base_us;
+}
+
+uint8_t servo_angle_to_pwm(uint8_t ch, uint8_t angle)
+{
+    return cal_pwm(ch, angle);
+}
+
+/* Lage des Servos im Zyklus now: während der Stellzeit linear zwischen
+   Start- und Zielwinkel der laufenden Bewegung, danach der Zielwinkel */
+static uint8_t servo_position(uint8_t ch, uint16_t now)
+{
+    const Servo *s = &servos[ch];
+    uint16_t elapsed = now - s->start;
+    uint8_t travel = servo_travel_frames(ch, s->from, s->angle);
+
+    if (elapsed >= travel)
+        return s->angle;
+    return s->from + (int16_t)((int32_t)(s->angle - s->from) * elapsed / travel);
+}
+
+uint8_t servo_move(uint8_t ch, uint8_t angle)
+{
+    Servo *s = &servos[ch];
+    uint16_t now = pwm_get_frames();
+    uint8_t frames;
+
+    /* Eine noch laufende Bewegung wird ersetzt, nicht abgewartet: Weg und
+       Beruhigung ab der schon erreichten Lage */
+    s->from = servo_position(ch, now);
+    s->start = now;
+    frames = servo_move_frames(ch, s->from, angle);
+    s->ready = now + frames;
+    servo_travel += (angle > s->angle) ? angle - s->angle : s->angle - angle;
+    s->angle = angle;
+    pwm_setting[ch] = servo_angle_to_pwm(ch, angle);
+    return frames;
+}
+
+uint8_t servo_travel_frames(uint8_t ch, uint8_t from, uint8_t to)
+{
+    uint8_t delta = (to > from) ? to - from : from - to;
+    uint16_t frames;
+
+    frames = (uint16_t)(((uint32_t)delta * servos[ch].travel_us + SERVO_FRAME_US - 1) / SERVO_FRAME_US);
+    return (frames > 255) ? 255 : (uint8_t)frames;
+}
+
+uint8_t servo_move_frames(uint8_t ch, uint8_t from, uint8_t to)
+{
+    const Servo *s = &servos[ch];
+    uint8_t delta = (to > from) ? to - from : from - to;
+    uint16_t frames;
+
+    frames = (uint16_t)(((uint32_t)delta * (s->travel_us + s->settle_us) + s->settle_base_us
+                         + SERVO_FRAME_US - 1) / SERVO_FRAME_US);
+    return (frames > 255) ? 255 : (uint8_t)frames;
+}
+
+void servo_commit(void)
+{
+    STATS_INC(frames);
+    pwm_update();
+    pwm_wait_frame();                   // ein Satz je PWM-Zyklus
+}
+
+uint8_t servo_busy(void)
+{
+    uint8_t ch;
+    uint16_t now = pwm_get_frames();
+
+    for (ch = 0; ch < SERVO_COUNT; ch++)
+    {
+        if ((int16_t)(servos[ch].ready - now) > 0)
+            return 1;
+    }
+    return 0;
+}
+
+void servo_wait(void)
+{
+    while (servo_busy())
+        pwm_wait_frame();
+}
@@ -0,0 +1,69 @@
+#ifndef SERVO_H
+#define SERVO_H
+
+#include <stdint.h>
+#include "pwm.h"
+
+/* Zuordnung der Servos zu den PWM-Kanälen */
+#define SERVO_LIFT      0               // Hubservo (Stift heben/senken)
+#define SERVO_LEFT      1               // linker Arm
+#define SERVO_RIGHT     2               // rechter Arm
+#define SERVO_COUNT     PWM_CHANNELS
+
+/* Zeitbasis des Bewegungsmodells: ein PWM-Zyklus */
+#define SERVO_FRAME_US  (1000000L / F_PWM)
+
+/* Standardwerte des Bewegungsmodells (Servo der SG90-Klasse, ca. 0,1 s / 60°) */
+#define SERVO_TRAVEL_US_PER_DEG   1700  // Stellzeit pro Grad Weg [µs]
+#define SERVO_SETTLE_US_PER_DEG    150  // Nachschwingen pro Grad Weg [µs]
+#define SERVO_SETTLE_US          20000  // feste Beruhigungszeit je Bewegung [µs]
+
+/* Bewegungsmodell eines Servos */
+typedef struct
+{
+    uint8_t  angle;                     // zuletzt kommandierter Winkel [°]
+    uint8_t  from;                      // Lage zu Beginn der laufenden Bewegung [°]
+    uint16_t start;                     // PWM-Zyklus, in dem sie kommandiert wurde
+    uint16_t travel_us;                 // Stellzeit pro Grad [µs]
+    uint16_t settle_us;                 // Beruhigungszeit pro Grad [µs]
+    uint16_t settle_base_us;            // feste Beruhigungszeit [µs]
+    uint16_t ready;                     // PWM-Zyklus, ab dem die Bewegung abgeschlossen ist
+} Servo;
+
+/* Summe aller kommandierten Servowege [°] seit dem Start */
+extern uint32_t servo_travel;
+
+/* Setzt alle Servos auf die Standardwerte des Bewegungsmodells (ohne PWM-Ausgabe) */
+void servo_init(void);
+
+/* Passt das Bewegungsmodell eines Servos an (Zeiten in µs) */
+void servo_config(uint8_t ch, uint16_t travel_us, uint16_t settle_us, uint16_t settle_base_us);
+
+/* Winkel [0..180°] -> PWM-Wert nach der Kalibrierung des Kanals ch (calib.h) */
+uint8_t servo_angle_to_pwm(uint8_t ch, uint8_t angle);
+
+/* Kommandiert einen neuen Winkel (wirksam mit servo_commit()). Er ersetzt
+   eine noch laufende Bewegung: gerechnet wird von der bis jetzt erreichten
+   Lage aus, nicht vom Ende der vorherigen.
+   Rückgabe: voraussichtliche Dauer der Bewegung in PWM-Zyklen */
+uint8_t servo_move(uint8_t ch, uint8_t angle);
+
+/* Reine Stellzeit (ohne Beruhigung) von from nach to in PWM-Zyklen */
+uint8_t servo_travel_frames(uint8_t ch, uint8_t from, uint8_t to);
+
+/* Vollständige Bewegungsdauer (Stellzeit und Beruhigung) von from nach to in PWM-Zyklen.
+   Ändert das Modell nicht; für im Voraus berechnete Abläufe */
+uint8_t servo_move_frames(uint8_t ch, uint8_t from, uint8_t to);
+
+/* Übernimmt alle mit servo_move() gesetzten Winkel in die PWM-Ausgabe und
+   wartet bis zum Zyklusende, an dem die ISR sie übernimmt */
+void servo_commit(void);
+
+/* Liefert 1, solange laut Modell noch ein Servo in Bewegung ist */
+uint8_t servo_busy(void);
+
+/* Wartet, bis laut Modell alle Servos ihr Ziel erreicht haben und ruhig stehen.
+   Ersetzt die früheren festen Wartezeiten (30/50/200 ms) */
+void servo_wait(void);
+
+#endif // SERVO_H
@@ -0,0 +1,87 @@
+#include "stats.h"
+#include <avr/eeprom.h>
+#include <util/crc16.h>
+#include <stddef.h>
+#include "servo.h"
+
+/* Ein Platz im EEPROM */
+typedef struct
+{
+    uint8_t  version;
+    uint16_t seq;                       // Folgenummer, der jüngste Platz hat die größte
+    Stats    stats;
+    uint8_t  crc;                       // CRC-8 über version, seq und stats
+} StatsSlot;
+
+static StatsSlot stats_eeprom[STATS_SLOTS] EEMEM;
+
+Stats stats;
+
+static uint8_t stats_slot;              // zuletzt geschriebener Platz
+static uint16_t stats_seq;
+static uint32_t stats_travel_base;      // servo_travel bei der letzten Sicherung
+static uint8_t stats_minutes;
+
+static uint8_t stats_crc(const StatsSlot *slot)
+{
+    const uint8_t *p = (const uint8_t *)slot;
+    uint8_t crc = 0;
+    uint8_t i;
+
+    for (i = 0; i < offsetof(StatsSlot, crc); i++)
+        crc = _crc8_ccitt_update(crc, p[i]);
+    return crc;
+}
+
+void stats_load(void)
+{
+    StatsSlot slot;
+    uint8_t i, found = 0;
+
+    for (i = 0; i < STATS_SLOTS; i++)
+    {
+        eeprom_read_block(&slot, &stats_eeprom[i], sizeof(slot));
+        if (slot.version != STATS_VERSION || slot.crc != stats_crc(&slot))
+            continue;
+        if (!found || (int16_t)(slot.seq - stats_seq) > 0)
+        {
+            found = 1;
+            stats_slot = i;
+            stats_seq = slot.seq;
+            stats = slot.stats;
+        }
+    }
+    if (!found)
+        stats_slot = STATS_SLOTS - 1;   // erste Sicherung in Platz 0
+    stats_travel_base = servo_travel;
+}
+
+void stats_minute(void)
+{
+    if (stats_minutes < STATS_SAVE_MINUTES)
+        stats_minutes++;
+}
+
+void stats_idle(void)
+{
+    if (stats_minutes >= STATS_SAVE_MINUTES)
+        stats_save();
+}
+
+void stats_save(void)
+{
+    StatsSlot slot;
+    uint32_t travel = servo_travel;
+
+    stats.travel += travel - stats_travel_base;
+    stats_travel_base = travel;
+    stats_minutes = 0;
+
+    if (++stats_slot >= STATS_SLOTS)
+        stats_slot = 0;
+    slot.version = STATS_VERSION;
+    slot.seq = ++stats_seq;
+    slot.stats = stats;
+    slot.crc = stats_crc(&slot);
+    eeprom_update_block(&slot, &stats_eeprom[stats_slot], sizeof(slot));
+}
@@ -0,0 +1,49 @@
+#ifndef STATS_H
+#define STATS_H
+
+#include <stdint.h>
+
+/* Langzeitzähler über Stromausfälle hinweg (Auswertung im Feld).
+   Gezählt wird nur in der Schattenkopie im SRAM (STATS_INC, wenige Takte);
+   stats_idle() schreibt sie alle STATS_SAVE_MINUTES Minuten gesammelt ins
+   EEPROM. Die Sicherungen laufen reihum über STATS_SLOTS Plätze, jeder mit
+   Folgenummer und CRC-8; geladen wird der jüngste gültige Platz. Bei
+   Stromausfall gehen höchstens die Zählungen seit der letzten Sicherung
+   verloren, ein unterbrochener Schreibvorgang trifft nur den neuen Platz.
+
+   Lebensdauer: 96 Sicherungen am Tag verteilt auf 8 Plätze ergeben
+   ca. 4400 Schreibzyklen je Zelle und Jahr (EEPROM: 100 000). */
+#define STATS_SLOTS         8
+#define STATS_SAVE_MINUTES  15
+#define STATS_VERSION       2           // Kennung des EEPROM-Formats
+
+typedef struct
+{
+    uint16_t sync_attempts;             // Einschaltvorgänge des DCF-Moduls
+    uint16_t sync_ok;                   // erfolgreiche Synchronisationen
+    uint32_t dcf_fail;                  // DCF_FAIL-Ereignisse (Abtastfehler)
+    uint32_t rx_seconds;                // Betriebszeit des DCF-Empfängers [s]
+    uint32_t frames;                    // ausgegebene Servozyklen (20 ms)
+    uint32_t travel;                    // Servoweg [°]
+    uint16_t sync_aborted;              // wegen schlechten Empfangs abgebrochene Versuche
+    uint32_t rx_wasted;                 // Empfängerbetrieb der abgebrochenen Versuche [s]
+} Stats;
+
+/* Summen seit der ersten Inbetriebnahme (nur aus dem Hauptprogramm ändern) */
+extern Stats stats;
+
+#define STATS_INC(field)    (stats.field++)
+
+/* Lädt den jüngsten gültigen Stand aus dem EEPROM (sonst alles 0) */
+void stats_load(void);
+
+/* Zählt Minuten bis zur nächsten Sicherung (beim Minutenwechsel aufrufen) */
+void stats_minute(void);
+
+/* Sichert, falls fällig; nur im Leerlauf aufrufen (ca. 30 Byte à 8,5 ms) */
+void stats_idle(void);
+
+/* Sichert sofort in den nächsten Platz */
+void stats_save(void);
+
+#endif // STATS_H
@@ -0,0 +1,159 @@
+#include "stroke.h"
+#include "kinematics.h"
+
+/* Kleinste Zweierpotenz-Schrittzahl für die Länge length, begrenzt auf max_shift */
+static uint8_t step_shift(uint16_t length, uint8_t max_shift)
+{
+    uint8_t shift = 0;
+
+    while (shift < max_shift && ((uint32_t)STROKE_STEP << shift) < length)
+        shift++;
+    return shift;
+}
+
+static uint16_t distance(int16_t dx, int16_t dy)
+{
+    return kin_isqrt((int32_t)dx * dx + (int32_t)dy * dy);
+}
+
+/* Kubisches Segment P0..P3 (relativ zu P0) vorbereiten:
+   P(t) = c3 t³ + c2 t² + c1 t, h = 2^-m, Skalierung 2^3m */
+static void cubic_setup(StrokeGen *gen, int16_t x0, int16_t y0,
+                        int16_t x1, int16_t y1, int16_t x2, int16_t y2, int16_t x3, int16_t y3)
+{
+    int32_t c1, c2, c3;
+    uint8_t m;
+
+    m = step_shift(distance(x1 - x0, y1 - y0) + distance(x2 - x1, y2 - y1) + distance(x3 - x2, y3 - y2),
+                   STROKE_MAX_SHIFT_3);
+    gen->ox = x0;
+    gen->oy = y0;
+    gen->x = gen->y = 0;
+    gen->shift = 3 * m;
+    gen->steps = 1 << m;
+
+    c1 = 3L * (x1 - x0);
+    c2 = 3L * (x0 - 2L * x1 + x2);
+    c3 = (int32_t)x3 - x0 + 3L * (x1 - x2);
+    gen->d1x = c3 + c2 * (1L << m) + c1 * (1L << (2 * m));
+    gen->d2x = 6 * c3 + c2 * (2L << m);
+    gen->d3x = 6 * c3;
+
+    c1 = 3L * (y1 - y0);
+    c2 = 3L * (y0 - 2L * y1 + y2);
+    c3 = (int32_t)y3 - y0 + 3L * (y1 - y2);
+    gen->d1y = c3 + c2 * (1L << m) + c1 * (1L << (2 * m));
+    gen->d2y = 6 * c3 + c2 * (2L << m);
+    gen->d3y = 6 * c3;
+}
+
+/* Nächstes Bogensegment (<= 90°) als kubische Bézierkurve vorbereiten */
+static void arc_segment(StrokeGen *gen)
+{
+    int16_t part = gen->sweep;
+    int16_t a0 = gen->angle;
+    int16_t a1, k, x0, y0, x3, y3;
+    int16_t s0, c0, s1, c1;
+
+    if (part > KIN_DEG(90))
+        part = KIN_DEG(90);
+    else if (part < -KIN_DEG(90))
+        part = -KIN_DEG(90);
+    a1 = a0 + part;
+    gen->angle = a1;
+    gen->sweep -= part;
+
+    /* Länge der Tangentenvektoren: 4/3 * tan(Bogen/4) * r */
+    k = (int16_t)((4L * gen->r * kin_sin(part / 4)) / (3L * kin_cos(part / 4)));
+
+    s0 = kin_sin(a0);
+    c0 = kin_cos(a0);
+    s1 = kin_sin(a1);
+    c1 = kin_cos(a1);
+    x0 = gen->cx + (int16_t)(((int32_t)gen->r * c0 + 8192) >> 14);
+    y0 = gen->cy + (int16_t)(((int32_t)gen->r * s0 + 8192) >> 14);
+    x3 = gen->cx + (int16_t)(((int32_t)gen->r * c1 + 8192) >> 14);
+    y3 = gen->cy + (int16_t)(((int32_t)gen->r * s1 + 8192) >> 14);
+    cubic_setup(gen, x0, y0,
+                x0 - (int16_t)(((int32_t)k * s0 + 8192) >> 14),
+                y0 + (int16_t)(((int32_t)k * c0 + 8192) >> 14),
+                x3 + (int16_t)(((int32_t)k * s1 + 8192) >> 14),
+                y3 - (int16_t)(((int32_t)k * c1 + 8192) >> 14),
+                x3, y3);
+}
+
+void stroke_begin(StrokeGen *gen, const Stroke *stroke)
+{
+    const int16_t *p = stroke->p;
+    uint8_t m;
+
+    gen->d2x = gen->d2y = gen->d3x = gen->d3y = 0;
+    gen->sweep = 0;
+
+    switch (stroke->type)
+    {
+    case STROKE_LINE:
+        /* P(t) = P0 + t (P1 - P0), Skalierung 2^m */
+        m = step_shift(distance(p[2] - p[0], p[3] - p[1]), STROKE_MAX_SHIFT_1);
+        gen->ox = p[0];
+        gen->oy = p[1];
+        gen->x = gen->y = 0;
+        gen->d1x = p[2] - p[0];
+        gen->d1y = p[3] - p[1];
+        gen->shift = m;
+        gen->steps = 1 << m;
+        break;
+    case STROKE_QUAD:
+        /* P(t) = c2 t² + c1 t, Skalierung 2^2m */
+        m = step_shift(distance(p[2] - p[0], p[3] - p[1]) + distance(p[4] - p[2], p[5] - p[3]),
+                       STROKE_MAX_SHIFT_1);
+        gen->ox = p[0];
+        gen->oy = p[1];
+        gen->x = gen->y = 0;
+        gen->shift = 2 * m;
+        gen->steps = 1 << m;
+        gen->d2x = 2L * (p[0] - 2L * p[2] + p[4]);
+        gen->d2y = 2L * (p[1] - 2L * p[3] + p[5]);
+        gen->d1x = gen->d2x / 2 + 2L * (p[2] - p[0]) * (1L << m);
+        gen->d1y = gen->d2y / 2 + 2L * (p[3] - p[1]) * (1L << m);
+        break;
+    case STROKE_CUBIC:
+        cubic_setup(gen, p[0], p[1], p[2], p[3], p[4], p[5], p[6], p[7]);
+        break;
+    case STROKE_ARC:
+        gen->cx = p[0];
+        gen->cy = p[1];
+        gen->r = p[2];
+        gen->angle = p[3];
+        gen->sweep = p[4];
+        arc_segment(gen);
+        break;
+    default:
+        gen->steps = 0;
+    }
+}
+
+uint8_t stroke_next(StrokeGen *gen, int16_t *x, int16_t *y)
+{
+    int32_t half;
+
+    if (gen->steps == 0)
+    {
+        if (gen->sweep == 0)
+            return 0;
+        arc_segment(gen);               // nächstes Bogensegment
+    }
+
+    gen->x += gen->d1x;
+    gen->y += gen->d1y;
+    gen->d1x += gen->d2x;
+    gen->d1y += gen->d2y;
+    gen->d2x += gen->d3x;
+    gen->d2y += gen->d3y;
+    gen->steps--;
+
+    half = (gen->shift != 0) ? (1L << (gen->shift - 1)) : 0;
+    *x = gen->ox + (int16_t)((gen->x + half) >> gen->shift);
+    *y = gen->oy + (int16_t)((gen->y + half) >> gen->shift);
+    return 1;
+}
@@ -0,0 +1,62 @@
+#ifndef STROKE_H
+#define STROKE_H
+
+#include <stdint.h>
+
+/* Strichelemente im Stiftraum (Koordinaten in 1/16 mm, Winkel in 1/16 Grad).
+   Die Generatoren liefern pro Aufruf (= pro PWM-Zyklus) den nächsten Punkt
+   durch Vorwärtsdifferenzen: je Schritt nur Additionen und ein Shift, keine
+   Multiplikation und kein sin/cos.
+
+   Die Schrittzahl ist immer eine Zweierpotenz 2^m. Mit Schrittweite h = 2^-m
+   sind alle Differenzen, skaliert mit 2^(g*m) (g = Grad des Polynoms), ganze
+   Zahlen; die Summation ist damit exakt und es sammelt sich kein
+   Rundungsfehler an.
+
+   Fehlerschranken (gegenüber der exakten Kurve):
+   - Linie, Bézier: <= 0,5 Einheiten (Rundung des ausgegebenen Punktes)
+   - Kreisbogen: zerlegt in kubische Béziers mit <= 90°; Radialfehler
+     <= 2,7e-4 * r + 2 Einheiten (Kontrollpunkte aus Q14-sin/cos gerundet)
+
+   Aufwand je Schritt: Linie 2, Quadratisch 4, Kubisch 6 Additionen (32 Bit)
+   plus Rundung; die Multiplikationen fallen nur beim Start eines Segments an. */
+#define STROKE_STEP         8           // angestrebter Stiftweg pro Schritt [1/16 mm] (~25 mm/s)
+#define STROKE_MAX_SHIFT_1  8           // max. 256 Schritte (Linie, Quadratisch)
+#define STROKE_MAX_SHIFT_3  6           // max. 64 Schritte je kubischem Segment
+
+typedef enum
+{
+    STROKE_LINE  = 0,                   // p: x0, y0, x1, y1
+    STROKE_ARC   = 1,                   // p: cx, cy, r, Startwinkel, Bogen (vorzeichenbehaftet)
+    STROKE_QUAD  = 2,                   // p: x0, y0, x1, y1, x2, y2
+    STROKE_CUBIC = 3                    // p: x0, y0, x1, y1, x2, y2, x3, y3
+} StrokeType;
+
+typedef struct
+{
+    uint8_t type;                       // StrokeType
+    int16_t p[8];
+} Stroke;
+
+/* Zustand eines laufenden Generators */
+typedef struct
+{
+    int16_t ox, oy;                     // Bezugspunkt (Segmentanfang)
+    int32_t x, y;                       // Position relativ zu (ox, oy), skaliert
+    int32_t d1x, d1y;                   // 1. Differenz
+    int32_t d2x, d2y;                   // 2. Differenz
+    int32_t d3x, d3y;                   // 3. Differenz
+    uint16_t steps;                     // verbleibende Schritte im Segment
+    uint8_t shift;                      // Skalierung 2^shift
+    /* Kreisbogen: noch nicht erzeugte Segmente */
+    int16_t cx, cy, r;
+    int16_t angle, sweep;
+} StrokeGen;
+
+/* Startet den Generator für ein Strichelement */
+void stroke_begin(StrokeGen *gen, const Stroke *stroke);
+
+/* Liefert den nächsten Punkt; Rückgabe 0, wenn das Element fertig ist */
+uint8_t stroke_next(StrokeGen *gen, int16_t *x, int16_t *y);
+
+#endif // STROKE_H
@@ -0,0 +1,56 @@
+#include "ticks.h"
+
+volatile uint32_t tick_overflows;
+
+/* Ausgleich für das Zurücksetzen von TCNT2 (ticks_restart_second) */
+static uint32_t tick_offset;
+
+uint32_t ticks_now(void)
+{
+    uint32_t ovf;
+    uint8_t t, pending;
+
+    /* Ohne Sperre: wiederholen, falls der Überlauf-Interrupt dazwischen kam
+       (zerrissene 32-Bit-Werte werden dabei mit erkannt) */
+    do
+    {
+        ovf = tick_overflows;
+        t = TCNT2;
+        pending = TIFR & (1 << TOV2);
+    }
+    while (ovf != tick_overflows);
+
+    /* Überlauf steht an, ist aber noch nicht gezählt (Interrupts gesperrt
+       oder ISR noch nicht gelaufen). Kleines t: TCNT2 wurde nach dem
+       Überlauf gelesen */
+    if (pending && t < 128)
+        ovf++;
+    return (ovf << 8) + t + tick_offset;
+}
+
+uint32_t ticks_since(uint32_t start)
+{
+    return ticks_now() - start;
+}
+
+uint8_t ticks_elapsed(uint32_t start, uint32_t duration)
+{
+    return ticks_now() - start >= duration;
+}
+
+void ticks_restart_second(uint8_t phase)
+{
+    uint32_t now = ticks_now();
+
+    while (ASSR & (1 << TCN2UB));
+    TCNT2 = phase;
+    while (ASSR & (1 << TCN2UB));
+    TIFR = (1 << TOV2);                 // nur TOV2 löschen
+    tick_offset = now - (tick_overflows << 8) - phase;
+}
+
+void ticks_wake(void)
+{
+    OCR2 = OCR2;                        // beliebiger Schreibzugriff startet die Synchronisation
+    while (ASSR & (1 << OCR2UB));
+}
@@ -0,0 +1,49 @@
+#ifndef TICKS_H
+#define TICKS_H
+
+#include <avr/io.h>
+#include <stdint.h>
+
+/* Monotone Zeitbasis aus der RTC (Timer2, 32,768 kHz / 128):
+   Ticks = Überläufe (1 Hz) * 256 + TCNT2, Auflösung 1/256 s (3,9 ms).
+   Der 32-Bit-Zähler läuft nach 2^24 s (~194 Tage) über; Zeitdifferenzen
+   mit ticks_since()/ticks_elapsed() bleiben dabei richtig.
+
+   Lesekosten von ticks_now(): ca. 60 Takte (15 µs bei 4 MHz), ohne
+   Interruptsperre; aufrufbar aus dem Hauptprogramm und aus ISRs, auch bei
+   gesperrten Interrupts (ein anstehender Überlauf wird über TOV2 erkannt).
+
+   Asynchroner Timer: TCNT2 wird mit dem Quarztakt aktualisiert. Direkt nach
+   dem Aufwachen aus Power-save liefert TCNT2 noch den alten Wert; dort
+   vor dem Lesen ticks_wake() aufrufen. Im Idle-Modus ist das nicht nötig. */
+#define TICKS_PER_SECOND    256
+#define TICKS_MS(ms)        ((uint32_t)(ms) * TICKS_PER_SECOND / 1000)
+
+/* Anzahl Timer2-Überläufe (von der Timer2-ISR gezählt) */
+extern volatile uint32_t tick_overflows;
+
+/* Aus ISR(TIMER2_OVF_vect) aufzurufen */
+static inline void ticks_overflow(void)
+{
+    tick_overflows++;
+}
+
+/* Aktueller Stand in 1/256 s */
+uint32_t ticks_now(void);
+
+/* Seit start vergangene Ticks */
+uint32_t ticks_since(uint32_t start);
+
+/* Liefert 1, sobald seit start mindestens duration Ticks vergangen sind */
+uint8_t ticks_elapsed(uint32_t start, uint32_t duration);
+
+/* Setzt TCNT2 auf phase (Sekundenbeginn der RTC neu festlegen: die laufende
+   Sekunde ist bereits phase/256 s alt), ohne dass der Tickzähler springt;
+   ein anstehender Überlauf wird verworfen. Mit gesperrten Interrupts aufrufen */
+void ticks_restart_second(uint8_t phase);
+
+/* Synchronisiert das Lesen von TCNT2 nach dem Aufwachen aus Power-save
+   (wartet bis zu zwei Quarztakte, ~61 µs) */
+void ticks_wake(void);
+
+#endif // TICKS_H
@@ -0,0 +1,73 @@
+#!/bin/sh
+# Laufzeit- und Speichermessung der Firmware unter simavr (siehe bench.h).
+#
+#   tools/bench/run.sh            messen und mit tools/bench/baseline.txt vergleichen
+#   tools/bench/run.sh --update   Messung als neue Referenz speichern
+#
+# Benötigt avr-g++, avr-size und simavr im PATH (andere Namen über
+# AVRGXX, AVRSIZE, SIMAVR). Ohne Referenz wird die erste Messung zur
+# Referenz. Rückgabe 1, wenn ein Wert um mehr als BENCH_TOLERANCE Prozent
+# (Vorgabe 2) über der Referenz liegt oder die DCF-Decodierung fehlschlägt.
+# Zusätzliche Schalter für beide Builds über BENCH_DEFS, z.B.
+#   BENCH_DEFS="-DDCF_SAMPLE_TIMER1 -DDISPLAY_BCM" tools/bench/run.sh
+# (misst dann auch die Helligkeitsstufen der Anzeige, siehe bench.h).
+set -e
+cd "$(dirname "$0")/../.."
+
+AVRGXX=${AVRGXX:-avr-g++}
+AVRSIZE=${AVRSIZE:-avr-size}
+SIMAVR=${SIMAVR:-simavr}
+TOL=${BENCH_TOLERANCE:-2}
+OUT=_bench
+BASE=tools/bench/baseline.txt
+CFLAGS="-mmcu=atmega8 -DF_CPU=4000000UL -Os -std=gnu++14 -fno-exceptions \
+        -fno-threadsafe-statics -ffunction-sections -fdata-sections -Wl,--gc-sections -I. $BENCH_DEFS"
+
+mkdir -p $OUT
+$AVRGXX $CFLAGS -o $OUT/plotclock.elf *.cpp
+$AVRGXX $CFLAGS -DBENCH -o $OUT/bench.elf *.cpp
+
+# Speicherbedarf des Uhrbetriebs (ohne Messcode)
+$AVRSIZE -A $OUT/plotclock.elf | awk '
+    $1 == ".text" || $1 == ".data" { flash += $2 }
+    $1 == ".data" || $1 == ".bss" || $1 == ".noinit" { sram += $2 }
+    $1 == ".eeprom" { eeprom += $2 }
+    END { printf "flash %d\nsram %d\neeprom %d\n", flash, sram, eeprom }' > $OUT/result.txt
+
+# Messlauf: simavr gibt die UART-Ausgabe zeilenweise aus
+timeout 300 $SIMAVR -m atmega8 -f 4000000 $OUT/bench.elf > $OUT/sim.txt 2>&1 || true
+grep -q "BENCH end" $OUT/sim.txt || { echo "bench: Messlauf unvollständig, siehe $OUT/sim.txt"; exit 1; }
+if ! grep -q "BENCH dcf_decode ok" $OUT/sim.txt; then
+    echo "bench: DCF-Decodierung fehlgeschlagen"
+    exit 1
+fi
+grep -o "BENCH [a-z0-9_]* [0-9]* [0-9]* [0-9]*" $OUT/sim.txt |
+    awk '{ printf "%s.min %s\n%s.avg %s\n%s.max %s\n", $2, $3, $2, $4, $2, $5 }' >> $OUT/result.txt
+
+# Helligkeitsstufen der Anzeige (nur mit DISPLAY_BCM), nicht Teil des Vergleichs
+grep "^DISPLAY " $OUT/sim.txt | awk '
+    NR == 1 { printf "%-6s %8s %9s %9s %9s\n", "Stufe", "IRQ/s", "Last ppm", "Tastgrad", "uA/LED" }
+    { printf "%-6s %8s %9s %8.1f%% %9s\n", $2, $3, $4, $5 / 10.0, $6 }' || true
+
+if [ "$1" = "--update" ] || [ ! -f $BASE ]; then
+    cp $OUT/result.txt $BASE
+    echo "bench: Referenz gespeichert ($BASE)"
+    cat $BASE
+    exit 0
+fi
+
+# Vergleich mit der Referenz
+awk -v tol=$TOL '
+    NR == FNR { base[$1] = $2; next }
+    {
+        mark = ""
+        if (!($1 in base))
+            mark = "  (neu)"
+        else if ($2 > base[$1] * (1 + tol / 100.0)) {
+            mark = "  VERSCHLECHTERT"
+            bad = 1
+        } else if ($2 < base[$1])
+            mark = "  besser"
+        printf "%-28s %7d %7s%s\n", $1, $2, ($1 in base) ? base[$1] : "-", mark
+    }
+    END { exit bad }' $BASE $OUT/result.txt
@@ -0,0 +1,132 @@
+/* Prüfstand für den DCF77-Abtaster auf dem PC: dcf_sample() mit der
+   beim Übersetzen erzeugten Zustandstabelle (dcf77.cpp) läuft neben dem
+   früheren Abtaster mit der von Hand aufgestellten Tabelle (S0..S12) und
+   dem Vergleich mit allen sieben Schwellen je Schritt. Beide bekommen
+   dieselben Pegel; nach jedem Schritt müssen die Ereignisse gleich sein.
+   Die Tabellen selbst vergleicht schon ein static_assert in dcf77.cpp,
+   hier geht es um Schwellenfolge, Zählerüberlauf und Rücksetzen.
+
+   Eingaben: 200 Läufe zu 20000 Schritten (4 Mio. Abtastungen, 40000 s),
+   abwechselnd Sekunden mit 100/200-ms-Impulsen und gelegentlich
+   gekipptem Pegel, Dauerpegel LO (Überlauf des Zählers) und Rauschen.
+
+   Übersetzen (im Hauptverzeichnis, nur für DCF_SAMPLE_MS 10):
+     g++ -O2 -DF_CPU=4000000UL -Itools/plotsim -I. -o dcfcheck tools/dcfcheck.cpp
+   Aufruf:
+     ./dcfcheck
+   Rückgabe 1 bei Abweichungen. */
+#include <stdio.h>
+#include "stats.h"
+#include "dcf77.cpp"
+
+#if DCF_SAMPLE_MS != 10
+#error "dcfcheck vergleicht mit dem früheren 10-ms-Abtaster"
+#endif
+
+#define SIM_DEFINE8(r)      volatile uint8_t r;
+#define SIM_DEFINE16(r)     volatile uint16_t r;
+SIM_REGISTERS(SIM_DEFINE8, SIM_DEFINE16)
+
+Stats stats;
+
+#define RUNS    200
+#define STEPS   20000L
+
+static DCFEvent old_event = DCF_NONE;
+
+/* Früherer Abtaster (vor der erzeugten Tabelle), unverändert bis auf
+   das Ziel des Ereignisses */
+static void old_sample(void)
+{
+    static const ZetaValue old_zeta[][3] =
+    {
+        { { 0, 'e' }, { 1, 'a' }, { 0, 'x' } }, // S0
+        { { 2, 'x' }, { 1, 'x' }, { 0, 'e' } }, // S1
+        { { 7, 'x' }, { 2, 'x' }, { 3, 'x' } }, // S2
+        { { 4, 'x' }, { 0, 'e' }, { 3, 'x' } }, // S3
+        { { 5, 'x' }, { 0, 'e' }, { 4, 'x' } }, // S4
+        { { 6, 'x' }, { 0, 'e' }, { 5, 'x' } }, // S5
+        { {11, '0' }, { 0, 'e' }, { 6, 'x' } }, // S6
+        { { 8, 'x' }, { 7, 'x' }, { 0, 'e' } }, // S7
+        { { 0, 'e' }, { 8, 'x' }, { 9, 'x' } }, // S8
+        { {10, 'x' }, { 0, 'e' }, { 9, 'x' } }, // S9
+        { {11, '1' }, { 0, 'e' }, {10, 'x' } }, // S10
+        { {12, 'x' }, { 1, 'a' }, {11, 'x' } }, // S11
+        { { 0, 'e' }, { 1, 'm' }, {12, 'x' } }  // S12
+    };
+    static uint8_t state = 0;
+    static uint8_t tenMs = 0;
+    Input input;
+    char output;
+
+    if ( tenMs == DCF_T0 || tenMs == DCF_T1 || tenMs == DCF_T2 ||
+            tenMs == DCF_T3 || tenMs == DCF_T4 || tenMs == DCF_T5 ||
+            tenMs == DCF_T6 )
+        input = TI;
+    else if (DCF_SIGNAL)
+        input = HI;
+    else
+        input = LO;
+
+    output = old_zeta[state][(uint8_t)input].output;
+    state  = old_zeta[state][(uint8_t)input].state;
+
+    if (output == 'm')
+        tenMs = 0;
+    if (output == 'a')
+        tenMs = 0;
+    else if (output != 'x')
+        old_event = (DCFEvent)output;
+    tenMs++;
+}
+
+/* Reproduzierbarer Zufall (LCG) */
+static uint32_t seed = 1;
+
+static uint32_t random_next(void)
+{
+    seed = seed * 1103515245u + 12345u;
+    return seed >> 16;
+}
+
+int main(void)
+{
+    long samples = 0, events = 0, i;
+    int run, mode, level, pulse = 10;
+
+    for (run = 0; run < RUNS; run++)
+    {
+        for (i = 0; i < STEPS; i++)
+        {
+            mode = (i / 3000 + run) % 3;
+            if (mode == 0)
+            {
+                if (i % 100 == 0)
+                    pulse = random_next() % 2 ? 10 : 20;
+                level = i % 100 < pulse;
+                if (random_next() % 50 == 0)
+                    level = !level;
+            }
+            else if (mode == 1)
+                level = 0;
+            else
+                level = random_next() % 2;
+            PIND = level;
+
+            dcfEvent = DCF_NONE;
+            old_event = DCF_NONE;
+            dcf_sample();
+            old_sample();
+            if (dcfEvent != old_event)
+            {
+                printf("Abweichung in Lauf %d, Schritt %ld: '%c' statt '%c'\n", run, i, dcfEvent, old_event);
+                return 1;
+            }
+            if (dcfEvent != DCF_NONE)
+                events++;
+            samples++;
+        }
+    }
+    printf("%ld Abtastungen, %ld Ereignisse, keine Abweichung\n", samples, events);
+    return 0;
+}
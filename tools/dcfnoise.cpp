@@ -0,0 +1,188 @@
+/* Prüfstand für die Empfangsqualität (dcf77.h) auf dem PC: Abtaster,
+   Decoder und Bewertung aus dcf77.cpp bekommen ein gültiges Telegramm
+   (12:34, 1.4.26), bei dem ein Anteil der Sekunden durch Störimpulse
+   ersetzt ist (je Abtastung mit 1/7 HI). Je Störanteil (0, 10, 40, 70,
+   100 %) laufen höchstens zehn Minuten; ausgegeben werden die Zähler aus
+   dcf_quality und die Sekunde, in der dcf_quality_second() den Versuch
+   aufgibt. Das Hauptprogramm bricht dann nur ab, wenn seit dem
+   Einschalten schon synchronisiert wurde (main.cpp).
+
+   Erwartet: ungestört und 10 % kein Abbruch, ungestört alle Marken an
+   der erwarteten Stelle; 70 und 100 % Abbruch nach DCF_ABORT_WINDOWS
+   schlechten Fenstern hinter dem ersten (240 s).
+
+   Zum Schluss fällt die Spannung mitten in der Minute aus: bis Sekunde 19
+   ist ausgewertet, das Ereignis von Bit 20 liegt noch an. Genau eine
+   Minute später beginnt der Empfang mit Sekunde 21 neu (init_TCNT0_DCF,
+   dcf_expect wie in main.cpp). Die alte Bitnummer passt dann zufällig zum
+   Signal; übernommen werden darf trotzdem erst nach der nächsten
+   Minutenmarke bei Bit 35, nicht schon 14 s nach dem Einschalten.
+
+   Übersetzen (im Hauptverzeichnis):
+     g++ -O2 -DF_CPU=4000000UL -Itools/plotsim -I. -o dcfnoise tools/dcfnoise.cpp
+   Aufruf:
+     ./dcfnoise
+   Rückgabe 1, wenn ein Lauf nicht wie erwartet endet. */
+#include <stdio.h>
+#include "stats.h"
+#include "dcf77.cpp"
+
+#define SIM_DEFINE8(r)      volatile uint8_t r;
+#define SIM_DEFINE16(r)     volatile uint16_t r;
+SIM_REGISTERS(SIM_DEFINE8, SIM_DEFINE16)
+
+Stats stats;
+
+#define MINUTES     10
+
+static uint8_t bits[60];
+
+/* Reproduzierbarer Zufall (LCG) */
+static uint32_t seed = 1;
+
+static uint32_t random_next(void)
+{
+    seed = seed * 1103515245u + 12345u;
+    return seed >> 16;
+}
+
+/* BCD-Feld ab Bit first eintragen, liefert die Anzahl Einsen */
+static int bcd(int first, int count, int value)
+{
+    static const int weight[] = { 1, 2, 4, 8, 10, 20, 40, 80 };
+    int i, ones = 0;
+
+    for (i = count - 1; i >= 0; i--)
+    {
+        if (value >= weight[i])
+        {
+            value -= weight[i];
+            bits[first + i] = 1;
+            ones++;
+        }
+    }
+    return ones;
+}
+
+/* Eine Sekunde s der Minute abtasten, gestört (1/7 HI je Abtastung) oder
+   mit dem Impuls aus bits[]; process 0 = Ereignisse nicht auswerten */
+static void second(int s, int noisy, int process)
+{
+    const int samples = 1000 / DCF_SAMPLE_MS;
+    int k, pulse;
+
+    pulse = s < 59 ? (bits[s] ? 200 : 100) / DCF_SAMPLE_MS : 0;
+    for (k = 0; k < samples; k++)
+    {
+        PIND = noisy ? random_next() % 7 == 0 : k < pulse;
+        dcf_sample();
+        if (process)
+            dcf_process();
+    }
+}
+
+/* Ein Versuch mit noise % gestörten Sekunden, liefert die Sekunde des
+   Abbruchs oder 0 */
+static int run(int noise)
+{
+    const DcfQuality *q = &dcf_quality;
+    int m, s, noisy, marks, aborted = 0;
+
+    dcf_quality_reset();
+    for (m = 0; m < MINUTES && !aborted; m++)
+    {
+        for (s = 0; s < 60 && !aborted; s++)
+        {
+            noisy = (int)(random_next() % 100) < noise;
+            second(s, noisy, 1);
+            if (dcf_quality_second())
+                aborted = m * 60 + s + 1;
+        }
+    }
+
+    marks = q->marks_ok + q->marks_bad;
+    printf("%3d %%  %s", noise, aborted ? "Abbruch" : "weiter ");
+    if (aborted)
+        printf(" %4d s", aborted);
+    else
+        printf("       ");
+    printf("  %3u %% gültig, %4u Bits, %4u Fehler, Marken %u/%u",
+           q->quality, q->bits, q->fails, q->marks_ok, marks);
+    if (marks)
+        printf(" (%u %%)", q->marks_ok * 100 / marks);
+    printf("\n");
+
+    if (noise == 0)
+        return !aborted && q->quality == 100 && q->marks_bad == 0 && q->marks_ok > 0;
+    if (noise <= 10)
+        return !aborted;
+    if (noise >= 70)
+        return aborted == (DCF_ABORT_WINDOWS + 1) * DCF_QUALITY_SECONDS;
+    return 1;
+}
+
+/* Spannungsausfall nach Sekunde 20, Neustart eine Minute später bei
+   Sekunde 21; liefert 1, wenn erst nach der nächsten Minutenmarke bei
+   Bit 35 übernommen wird */
+static int power_cycle(void)
+{
+    const int resume = 21;
+    const int expected = 60 - resume + 35;
+    uint8_t h, m;
+    int s, n, synced = -1;
+
+    set_dcf_sync(0);
+    init_TCNT0_DCF();
+    for (s = 50; s < 60 + resume - 1; s++)
+        second(s % 60, 0, 1);
+    second(resume - 1, 0, 0);           // Bit 20 erkannt, nicht mehr ausgewertet
+
+    init_TCNT0_DCF();
+    dcf_expect(12, 33, 2);
+    for (n = 0; n < 2 * 60 && synced < 0; n++)
+    {
+        second((resume + n) % 60, 0, 1);
+        if (get_dcf_sync())
+            synced = n;
+    }
+
+    dcf_getTime(&h, &m);
+    printf("Neustart in Sekunde %d: ", resume);
+    if (synced < 0)
+        printf("keine Übernahme\n");
+    else
+        printf("Übernahme %02u:%02u nach %d s (erwartet nach %d s)\n", h, m, synced + 1, expected + 1);
+    return synced == expected && h == 12 && m == 33;
+}
+
+int main(void)
+{
+    static const int noise[] = { 0, 10, 40, 70, 100 };
+    int i, ones, ok = 1;
+
+    bits[18] = 1;                       // MEZ
+    bits[20] = 1;                       // Beginn der Zeitinformation
+    if (bcd(21, 7, 34) & 1)
+        bits[28] = 1;
+    if (bcd(29, 6, 12) & 1)
+        bits[35] = 1;
+    ones = bcd(36, 6, 1) + bcd(42, 3, 3) + bcd(45, 5, 4) + bcd(50, 8, 26);
+    if (ones & 1)
+        bits[58] = 1;
+
+    printf("Störung  Ergebnis   letztes Fenster\n");
+    for (i = 0; i < (int)(sizeof(noise) / sizeof(noise[0])); i++)
+    {
+        if (!run(noise[i]))
+        {
+            printf("  nicht wie erwartet\n");
+            ok = 0;
+        }
+    }
+    if (!power_cycle())
+    {
+        printf("  nicht wie erwartet\n");
+        ok = 0;
+    }
+    return !ok;
+}
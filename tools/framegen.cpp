@@ -0,0 +1,398 @@
+/* Erzeugt plotcache.h: die Servozyklen (Armwinkel links/rechts) aller Züge
+   der Glyphen in den Zellen, in denen sie vorkommen, und der Wischbahnen
+   der Bereiche, die beim Minutenwechsel gewischt werden. Mit
+   -DPLOT_FRAME_CACHE gibt plot.cpp diese Züge direkt aus, statt sie über
+   Strichgeneratoren bzw. Trapezprofil und inverse Kinematik zu berechnen.
+
+   plot.cpp wird dazu eingebunden (ohne PLOT_FRAME_CACHE): Zellen,
+   Wischbahn, Zerlegung in Pfade und die Differenz zur Tafel sind dieselben
+   wie in der Firmware. Welche Glyphen je Zelle und welche Wischbereiche
+   nötig sind, ergibt sich aus allen 1440 Minutenwechseln; was dort nicht
+   vorkommt (z. B. das Wischen der ganzen Tafel nach dem Start), wird
+   weiter berechnet.
+
+   Ein Zug wird vorwärts abgelegt: Winkel am Anfang und am Ende, dazu je
+   Zyklus ein Halbbyte mit der Änderung der Armwinkel (Format siehe
+   CACHE_ESCAPE in plotcache.h). Rückwärts gezeichnete Pfade laufen die
+   Codes vom Ende her ab: die Punkte des Vorwärtszugs in umgekehrter
+   Reihenfolge, nicht die der rückwärts laufenden Strichgeneratoren (sie
+   liegen um bis zu 1° daneben). Mit dem Cache werden die Strichgeneratoren
+   nicht mehr gebraucht; plot.cpp prüft beim Übersetzen, dass jede Glyphe
+   einer Uhrzeit in ihrer Zelle einen Zug hat (CACHE_GLYPH_MASKS).
+
+   Bericht (stderr): Flash des Caches gegenüber der Glyphentabelle, die
+   sonst allein die Züge beschreibt, und Zyklen je Minute aus dem Cache
+   bzw. weiter berechnet (je berechnetem Zyklus eine inverse Kinematik).
+
+   Vergleich mit der Berechnung: tools/plotsim mit und ohne
+   -DPLOT_FRAME_CACHE übersetzen. Zyklen und Dauer je Minute sind gleich;
+   die Weglängen weichen in den Minuten mit rückwärts gezeichneten Pfaden
+   ab (über einen Tag 28 Minuten, höchstens etwa 5 mm, z. B. xx:30).
+
+   Übersetzen (im Hauptverzeichnis):
+     g++ -O2 -DF_CPU=4000000UL -Itools/plotsim -I. -o framegen \
+         tools/framegen.cpp pwm.cpp servo.cpp calib.cpp stats.cpp \
+         motion.cpp kinematics.cpp glyph.cpp stroke.cpp
+   Aufruf:
+     ./framegen > plotcache.h
+   Rückgabe 1, wenn eine Änderung größer als -8 .. 7° ist. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+#include "plot.cpp"
+
+#define SIM_DEFINE8(r)      volatile uint8_t r;
+#define SIM_DEFINE16(r)     volatile uint16_t r;
+SIM_REGISTERS(SIM_DEFINE8, SIM_DEFINE16)
+
+#define MINUTES_PER_DAY     1440
+#define CACHE_NONE_INDEX    0xFF        // Eintrag ohne Zug (CACHE_NONE)
+#define CACHE_ESCAPE_CODE   0x0F        // Änderung außerhalb -1 .. 1° (CACHE_ESCAPE)
+
+struct Track
+{
+    uint8_t start[2], end[2];
+    std::vector<uint8_t> code;          // Halbbytes
+    unsigned frames;
+    const char *what;
+    int cell, glyph;                    // Glyphe bzw. Wischbereich (cell = Maske)
+};
+
+static std::vector<Track> tracks;
+static uint8_t need_glyph[PLOT_CELLS][GLYPH_COUNT];
+static uint8_t need_run[1 << PLOT_CELLS];
+static int errors;
+
+/* Hängt einen Zyklus an den Zug an (Änderung gegenüber dem vorherigen) */
+static void track_add(Track *t, uint8_t left, uint8_t right)
+{
+    int dl = left - t->end[0];
+    int dr = right - t->end[1];
+
+    if (dl < -8 || dl > 7 || dr < -8 || dr > 7)
+    {
+        fprintf(stderr, "framegen: %s %d/%d: Änderung %+d/%+d° zu groß\n",
+                t->what, t->cell, t->glyph, dl, dr);
+        errors++;
+    }
+    if (dl >= -1 && dl <= 1 && dr >= -1 && dr <= 1)
+        t->code.push_back((uint8_t)((dl + 1) << 2 | (dr + 1)));
+    else
+    {
+        /* in beiden Richtungen lesbar: Escape, links, rechts, Escape */
+        t->code.push_back(CACHE_ESCAPE_CODE);
+        t->code.push_back(dl & 0x0F);
+        t->code.push_back(dr & 0x0F);
+        t->code.push_back(CACHE_ESCAPE_CODE);
+    }
+    t->frames++;
+    t->end[0] = left;
+    t->end[1] = right;
+}
+
+static Track track_begin(const char *what, int cell, int glyph, int16_t x, int16_t y)
+{
+    Track t;
+
+    t.what = what;
+    t.cell = cell;
+    t.glyph = glyph;
+    t.frames = 0;
+    kin_inverse(x, y, &t.start[0], &t.start[1]);
+    t.end[0] = t.start[0];
+    t.end[1] = t.start[1];
+    return t;
+}
+
+/* Züge einer Glyphe in Zelle cell, wie plan_next() sie vorwärts zeichnet */
+static void render_glyph(uint8_t cell, uint8_t glyph)
+{
+    GlyphStroke g;
+    Stroke s;
+    StrokeGen gen;
+    Track t;
+    int16_t ox = cell_x[cell];
+    int16_t x = 0, y = 0, ex, ey;
+    uint8_t i, open = 0, left, right;
+
+    for (i = 0; glyph_read(glyph, i, &g); i++)
+    {
+        if (g.type == GLYPH_MOVE)
+        {
+            if (open)
+                tracks.push_back(t);
+            glyph_end(&g, ox, PLOT_CELL_Y, &x, &y);
+            t = track_begin("Glyphe", cell, glyph, x, y);
+            open = 1;
+            continue;
+        }
+        glyph_stroke(&g, ox, PLOT_CELL_Y, x, y, &s);
+        stroke_begin(&gen, &s);
+        while (stroke_next(&gen, &x, &y))
+        {
+            kin_inverse(x, y, &left, &right);
+            track_add(&t, left, right);
+        }
+        /* plot.cpp setzt die Stiftposition nach dem Zug auf den Endpunkt */
+        glyph_end(&g, ox, PLOT_CELL_Y, &ex, &ey);
+        if (x != ex || y != ey)
+        {
+            fprintf(stderr, "framegen: Glyphe %d in Zelle %d endet bei %d/%d statt %d/%d\n",
+                    glyph, cell, x, y, ex, ey);
+            errors++;
+        }
+    }
+    if (open)
+        tracks.push_back(t);
+}
+
+/* Zickzack über den Bereich run ab dem ersten Punkt mit gesenktem Schwamm,
+   wie plan_erase() ihn über motion abfährt */
+static void render_erase(uint8_t run)
+{
+    ServoFrame f;
+    Track t;
+    int16_t left, right, x, y;
+    uint8_t zig;
+
+    erase_run(run, 0, &left, &right);
+    erase_point(0, left, right, &x, &y);
+    t = track_begin("Wischbereich", run, 0, x, y);
+    motion_init(x, y);
+    for (zig = 1; zig < ERASE_POINTS; zig++)
+    {
+        erase_point(zig, left, right, &x, &y);
+        motion_start(x, y);
+        while (motion_next(&f))
+            track_add(&t, f.angle[SERVO_LEFT], f.angle[SERVO_RIGHT]);
+    }
+    tracks.push_back(t);
+}
+
+/* Uhrzeit nach minute (0 .. 1439) auf die Tafel, dann Wechsel zur nächsten Minute */
+static void minute_change(uint16_t minute)
+{
+    uint8_t cell;
+
+    job.hours = minute / 60;
+    job.minutes = minute % 60;
+    for (cell = 0; cell < PLOT_CELLS; cell++)
+        board[cell] = cell_glyph(cell);
+    minute = (minute + 1) % MINUTES_PER_DAY;
+    plot_reset(minute / 60, minute % 60);
+}
+
+/* Zyklen eines Minutenwechsels, davon aus dem Cache */
+static void minute_frames(uint32_t *total, uint32_t *cached)
+{
+    int16_t left, right;
+    uint8_t n, run;
+    size_t i;
+
+    buf_count = 0;
+    while (produce())
+    {
+        (*total)++;
+        buf_count = 0;
+    }
+    for (n = 0; (run = erase_run(job.erase, n, &left, &right)); n++)
+    {
+        for (i = 0; i < tracks.size(); i++)
+        {
+            if (tracks[i].what[0] == 'W' && tracks[i].cell == run)
+                *cached += tracks[i].frames;
+        }
+    }
+    for (n = 0; n < job.paths; n++)
+    {
+        uint8_t glyph = cell_glyph(paths[n].cell);
+        uint8_t k = 0, j;
+
+        for (j = 0; j < paths[n].first; j++)
+        {
+            GlyphStroke g;
+            glyph_read(glyph, j, &g);
+            if (g.type == GLYPH_MOVE)
+                k++;
+        }
+        for (i = 0; i < tracks.size(); i++)
+        {
+            if (tracks[i].what[0] == 'G' && tracks[i].cell == paths[n].cell &&
+                    tracks[i].glyph == glyph && k-- == 0)
+                *cached += tracks[i].frames;
+        }
+    }
+}
+
+int main(void)
+{
+    uint8_t glyph_index[PLOT_CELLS][GLYPH_COUNT];
+    std::vector<uint8_t> runs;
+    uint32_t frames = 0, cached = 0, worst = 0, bytes, glyph_bytes = 0;
+    int16_t left, right;
+    uint16_t minute;
+    uint8_t cell, glyph, n, run;
+    std::vector<uint8_t> code;
+    size_t i, offset, cycles = 0;
+    GlyphStroke g;
+
+    servo_init();
+
+    /* benötigte Glyphen je Zelle und Wischbereiche */
+    for (minute = 0; minute < MINUTES_PER_DAY; minute++)
+    {
+        minute_change(minute);
+        for (cell = 0; cell < PLOT_CELLS; cell++)
+        {
+            if (job.draw & (1 << cell))
+                need_glyph[cell][cell_glyph(cell)] = 1;
+        }
+        for (n = 0; (run = erase_run(job.erase, n, &left, &right)); n++)
+            need_run[run] = 1;
+    }
+
+    for (cell = 0; cell < PLOT_CELLS; cell++)
+    {
+        for (glyph = 0; glyph < GLYPH_COUNT; glyph++)
+        {
+            glyph_index[cell][glyph] = CACHE_NONE_INDEX;
+            if (!need_glyph[cell][glyph])
+                continue;
+            glyph_index[cell][glyph] = tracks.size();
+            render_glyph(cell, glyph);
+        }
+    }
+    for (run = 1; run < (1 << PLOT_CELLS); run++)
+    {
+        if (!need_run[run])
+            continue;
+        runs.push_back(run);
+        runs.push_back(tracks.size());
+        render_erase(run);
+    }
+    if (tracks.size() >= CACHE_NONE_INDEX)
+    {
+        fprintf(stderr, "framegen: zu viele Züge (%zu)\n", tracks.size());
+        return 1;
+    }
+    if (errors)
+        return 1;
+
+    /* Zyklen je Minutenwechsel über einen Tag */
+    for (minute = 0; minute < MINUTES_PER_DAY; minute++)
+    {
+        uint32_t before = frames;
+
+        minute_change(minute);
+        minute_frames(&frames, &cached);
+        if (frames - before > worst)
+            worst = frames - before;
+    }
+
+    for (i = 0; i < tracks.size(); i++)
+    {
+        cycles += tracks[i].frames;
+        code.insert(code.end(), tracks[i].code.begin(), tracks[i].code.end());
+    }
+    if (code.size() & 1)
+        code.push_back(0);
+    bytes = code.size() / 2 + (tracks.size() + 1) * 6 + sizeof(glyph_index) + runs.size();
+    for (glyph = 0; glyph < GLYPH_COUNT; glyph++)
+    {
+        for (n = 0; glyph_read(glyph, n, &g); n++);
+        glyph_bytes += (n + 1) * sizeof(GlyphStroke) + 1;
+    }
+
+    printf("#ifndef PLOTCACHE_H\n#define PLOTCACHE_H\n\n");
+    printf("/* Vorberechnete Servozyklen für plot.cpp (nur mit -DPLOT_FRAME_CACHE).\n"
+           "   Erzeugt mit tools/framegen.cpp, nicht von Hand ändern; nach Änderungen\n"
+           "   an Glyphen, Zellen, Wischbahn, Kinematik oder Bewegungsprofil neu\n"
+           "   erzeugen (./framegen > plotcache.h).\n"
+           "   %zu Züge, %zu Zyklen, %u Byte Flash */\n\n", tracks.size(), cycles, bytes);
+    printf("#include <stdint.h>\n#include <avr/pgmspace.h>\n#include \"plot.h\"\n"
+           "#include \"glyph.h\"\n#include \"stroke.h\"\n\n");
+    printf("#ifdef MOTION_NAIVE\n#error \"PLOT_FRAME_CACHE enthält das Trapezprofil, nicht mit MOTION_NAIVE\"\n#endif\n\n");
+    printf("static_assert(GLYPH_SCALE == %d && PLOT_CELL_Y == %d && STROKE_STEP == %d &&\n"
+           "              MOTION_VMAX == %d && MOTION_ACCEL_FRAMES == %d &&\n"
+           "              SERVO_TRAVEL_US_PER_DEG == %d && SERVO_FRAME_US == %ld &&\n"
+           "              KIN_L1 == %d && KIN_L2 == %d && KIN_L3 == %d && KIN_L4 == %d &&\n"
+           "              KIN_O1X == %d && KIN_O1Y == %d && KIN_O2X == %d && KIN_O2Y == %d,\n"
+           "              \"plotcache.h passt nicht zur Geometrie, mit tools/framegen neu erzeugen\");\n\n",
+           GLYPH_SCALE, PLOT_CELL_Y, STROKE_STEP, MOTION_VMAX, MOTION_ACCEL_FRAMES,
+           SERVO_TRAVEL_US_PER_DEG, SERVO_FRAME_US, KIN_L1, KIN_L2, KIN_L3, KIN_L4,
+           KIN_O1X, KIN_O1Y, KIN_O2X, KIN_O2Y);
+    printf("#define CACHE_NONE          0x%02X\n", CACHE_NONE_INDEX);
+    printf("#define CACHE_TRACKS        %zu\n", tracks.size());
+    printf("#define CACHE_ERASE_RUNS    %zu\n\n", runs.size() / 2);
+    printf("/* Je Zyklus ein Halbbyte (oberes zuerst): (links + 1) << 2 | (rechts + 1)\n"
+           "   für Änderungen der Armwinkel von -1 .. 1°, sonst CACHE_ESCAPE, links,\n"
+           "   rechts (je -8 .. 7°), CACHE_ESCAPE; damit auch rückwärts lesbar */\n");
+    printf("#define CACHE_ESCAPE        0x%X\n\n", CACHE_ESCAPE_CODE);
+    printf("/* Zug: erstes Halbbyte in cache_codes (Ende beim nächsten Eintrag),\n"
+           "   Armwinkel links/rechts [°] am Anfang und am Ende */\n"
+           "typedef struct\n{\n    uint16_t offset;\n    uint8_t start[2];\n    uint8_t end[2];\n} CacheTrack;\n\n");
+
+    printf("/* Erster Zug je Zelle und Glyphe (weitere Züge der Glyphe folgen) */\n");
+    printf("static const uint8_t cache_glyph[PLOT_CELLS][GLYPH_COUNT] PROGMEM =\n{\n");
+    for (cell = 0; cell < PLOT_CELLS; cell++)
+    {
+        printf("    {");
+        for (glyph = 0; glyph < GLYPH_COUNT; glyph++)
+            printf(" 0x%02X%s", glyph_index[cell][glyph], glyph + 1 < GLYPH_COUNT ? "," : "");
+        printf(" }%s\n", cell + 1 < PLOT_CELLS ? "," : "");
+    }
+    printf("};\n\n");
+
+    printf("/* Glyphen mit Zug je Zelle (Bitmaske, Prüfung in plot.cpp) */\n");
+    printf("#define CACHE_GLYPH_MASKS   {");
+    for (cell = 0; cell < PLOT_CELLS; cell++)
+    {
+        unsigned mask = 0;
+
+        for (glyph = 0; glyph < GLYPH_COUNT; glyph++)
+        {
+            if (glyph_index[cell][glyph] != CACHE_NONE_INDEX)
+                mask |= 1u << glyph;
+        }
+        printf(" 0x%04X%s", mask, cell + 1 < PLOT_CELLS ? "," : " }\n\n");
+    }
+
+    printf("/* Wischbereiche: Zellen (Bitmaske) und Zug */\n");
+    printf("static const uint8_t cache_erase_runs[CACHE_ERASE_RUNS][2] PROGMEM =\n{\n   ");
+    for (i = 0; i < runs.size(); i += 2)
+        printf(" { 0x%02X, %u }%s", runs[i], runs[i + 1], i + 2 < runs.size() ? "," : "\n");
+    printf("};\n\n");
+
+    printf("static const CacheTrack cache_tracks[CACHE_TRACKS + 1] PROGMEM =\n{\n");
+    offset = 0;
+    for (i = 0; i < tracks.size(); i++)
+    {
+        const Track &t = tracks[i];
+        printf("    { %5zu, { %3u, %3u }, { %3u, %3u } },    // %s ", offset,
+               t.start[0], t.start[1], t.end[0], t.end[1], t.what);
+        if (t.what[0] == 'G')
+            printf("%d, Zelle %d\n", t.glyph, t.cell);
+        else
+            printf("0x%02X\n", t.cell);
+        offset += t.code.size();
+    }
+    printf("    { %5zu, { 0, 0 }, { 0, 0 } }\n};\n\n", offset);
+
+    printf("static const uint8_t cache_codes[%zu] PROGMEM =\n{", code.size() / 2);
+    for (i = 0; i < code.size(); i += 2)
+    {
+        printf("%s0x%X%X%s", (i / 2) % 12 == 0 ? "\n    " : " ", code[i], code[i + 1],
+               i + 2 < code.size() ? "," : "");
+    }
+    printf("\n};\n\n#endif // PLOTCACHE_H\n");
+
+    fprintf(stderr, "framegen: %zu Züge (%zu Wischbereiche), %zu Zyklen, %u Byte Flash"
+            " (Glyphentabelle zum Vergleich %u Byte)\n",
+            tracks.size(), runs.size() / 2, cycles, bytes, glyph_bytes);
+    fprintf(stderr, "framegen: je Minute im Mittel %u Zyklen, davon %u aus dem Cache (%u %%),"
+            " %u berechnet; höchstens %u\n",
+            frames / MINUTES_PER_DAY, cached / MINUTES_PER_DAY,
+            frames ? (unsigned)(cached * 100 / frames) : 0,
+            (frames - cached) / MINUTES_PER_DAY, worst);
+    return 0;
+}
@@ -0,0 +1,309 @@
+/* Zeichnen vom PC aus (link.h): überträgt Servo- oder Stiftpositionen an
+   die Uhr und meldet jede Sekunde die erreichte Zyklusrate, Fehlzyklen
+   und Wiederholungen. Die Firmware muss mit -DTRACE -DLINK übersetzt sein.
+
+   Übersetzen:  g++ -O2 -o linkhost tools/linkhost.cpp
+   Aufruf:      ./linkhost /dev/ttyUSB0 [datei|-]
+
+   Eingabe (je Zeile ein PWM-Zyklus):
+     s <hub> <links> <rechts>     Servowinkel [°]
+     p <x> <y> <hub>              Stiftposition [mm], Hubwinkel [°]
+     k <kanal> <stützstelle> <µs> Stützstelle der Servokennlinie setzen
+                                  (calib.h; Kanal 0 Hub, 1 links,
+                                  2 rechts, Stützstelle k bei k * 32°)
+     k linear                     alle Kennlinien auf die lineare Zuordnung
+     i                            ISR-Statistik anfordern (LINK_ISR, Firmware
+                                  mit -DISR_STATS); nach dem Ende der
+                                  Übertragung wird sie ausgegeben
+   Beispiel Abgleich des linken Arms bei 96°: "k 1 3 1490", dann einige
+   Zyklen "s 38 96 90" und Lage prüfen, Wert anpassen, wiederholen.
+   Ein "k" belegt wie jede Zeile genau einen Zyklus; das EEPROM schreibt
+   die Uhr danach nebenher (ein Byte je Zyklus), Gutschriften und
+   RESEND_MS gelten daher unverändert.
+   Ohne Datei wird 10 s lang ein Kreis gefahren (Stift abgehoben).
+   Statt einer seriellen Schnittstelle geht auch ein Pseudoterminal, ohne
+   Uhr z. B. das der Gegenstelle tools/linksim.cpp. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+#include <sys/select.h>
+#include <sys/time.h>
+#include <vector>
+#include "../trace.h"
+#include "../link.h"
+
+#define RESEND_MS   250                 // ohne Quittung: ab der letzten angenommenen Folgenummer wiederholen
+#define DEMO_LIFT   38                  // Stift abgehoben (MOTION_LIFT_UP, motion.h)
+#define ISR_WAIT_MS 2000                // nach dem Ende höchstens so lange auf die ISR-Statistik warten
+
+/* Aufbau der ISR-Statistik (isrstat.h): je Interrupt die Kennung, dann
+   Laufzeit und Latenz mit je count, min, max und ISR_BUCKETS Klassen
+   (uint16 little endian) */
+#define ISR_COUNT   4                   // ISR_STAT_COUNT
+#define ISR_BUCKETS 8                   // ISR_STAT_BUCKETS
+#define ISR_STAT    (2 * (3 + ISR_BUCKETS))
+#define ISR_ENTRY   (1 + 2 * ISR_STAT)
+#define ISR_BYTES   (ISR_COUNT * ISR_ENTRY)
+#define ISR_TICK_US (8.0 / 4.0)         // Timer1-Tick: Prescaler 8 bei 4 MHz
+
+static uint8_t isr_data[ISR_BYTES];
+static uint8_t isr_got[ISR_BYTES];
+static unsigned isr_received;
+static int isr_requested;
+
+struct Frame
+{
+    uint8_t type;
+    uint8_t data[LINK_PAYLOAD];
+};
+
+static const uint8_t lengths[LINK_TYPES] = LINK_LENGTHS;
+
+/* entspricht _crc_ccitt_update (avr-libc) */
+static uint16_t crc_update(uint16_t crc, uint8_t data)
+{
+    data ^= (uint8_t)crc;
+    data ^= data << 4;
+    return ((((uint16_t)data << 8) | (crc >> 8)) ^ (uint8_t)(data >> 4) ^ ((uint16_t)data << 3));
+}
+
+static long now_ms(void)
+{
+    struct timeval tv;
+
+    gettimeofday(&tv, 0);
+    return tv.tv_sec * 1000L + tv.tv_usec / 1000;
+}
+
+static void send_frame(int fd, uint8_t seq, const Frame &f)
+{
+    uint8_t buf[5 + LINK_PAYLOAD];
+    uint16_t crc = 0xFFFF;
+    int n = 0, i;
+
+    buf[n++] = LINK_SOF;
+    buf[n++] = seq;
+    buf[n++] = f.type;
+    for (i = 0; i < lengths[f.type]; i++)
+        buf[n++] = f.data[i];
+    for (i = 1; i < n; i++)
+        crc = crc_update(crc, buf[i]);
+    buf[n++] = (uint8_t)crc;
+    buf[n++] = (uint8_t)(crc >> 8);
+    if (write(fd, buf, n) != n)
+        perror("write");
+}
+
+static Frame servo_frame(int lift, int left, int right)
+{
+    Frame f = { LINK_SERVO, { (uint8_t)lift, (uint8_t)left, (uint8_t)right } };
+    return f;
+}
+
+static Frame pos_frame(double x, double y, int lift)
+{
+    int16_t ix = (int16_t)lround(x * 16), iy = (int16_t)lround(y * 16);
+    Frame f = { LINK_POS, { (uint8_t)ix, (uint8_t)(ix >> 8), (uint8_t)iy, (uint8_t)(iy >> 8), (uint8_t)lift } };
+    return f;
+}
+
+static Frame cal_frame(int ch, int knot, int us)
+{
+    Frame f = { LINK_CAL, { (uint8_t)ch, (uint8_t)knot, (uint8_t)us, (uint8_t)(us >> 8) } };
+    return f;
+}
+
+/* Eine Statistik (Laufzeit oder Latenz) aus der ISR-Ausgabe */
+static void isr_print(const char *what, const uint8_t *p)
+{
+    unsigned count = p[0] | (p[1] << 8), b;
+
+    printf("    %-8s %5u Aufrufe", what, count);
+    if (count)
+        printf(", %.0f .. %.0f µs", (p[2] | (p[3] << 8)) * ISR_TICK_US, (p[4] | (p[5] << 8)) * ISR_TICK_US);
+    printf("\n      Klassen [Ticks]:");
+    for (b = 0; b < ISR_BUCKETS; b++)
+        printf(" %s%u:%u", b == ISR_BUCKETS - 1 ? ">=" : "", b ? 1u << b : 0, p[6 + 2 * b] | (p[7 + 2 * b] << 8));
+    printf("\n");
+}
+
+static void isr_report(void)
+{
+    static const char *names[ISR_COUNT] = { "DCF-Abtastung", "Soft-PWM (TIMER1_COMPA)", "RTC (TIMER2_OVF)", "Anzeige (TIMER0_OVF)" };
+    int id;
+
+    if (isr_received < ISR_BYTES)
+    {
+        printf("ISR-Statistik unvollständig (%u von %u Byte)\n", isr_received, ISR_BYTES);
+        return;
+    }
+    printf("ISR-Statistik (1 Tick = %.0f µs):\n", ISR_TICK_US);
+    for (id = 0; id < ISR_COUNT; id++)
+    {
+        const uint8_t *p = isr_data + id * ISR_ENTRY;
+
+        printf("  %u %s\n", p[0], p[0] < ISR_COUNT ? names[p[0]] : "?");
+        isr_print("Laufzeit", p + 1);
+        if (p[1 + ISR_STAT] | p[2 + ISR_STAT])
+            isr_print("Latenz", p + 1 + ISR_STAT);     // nur Timer1 Compare A
+    }
+}
+
+static void load(FILE *in, std::vector<Frame> &frames)
+{
+    char line[128];
+    double x, y;
+    int a, b, c;
+    char cmd;
+
+    while (fgets(line, sizeof(line), in))
+    {
+        if (sscanf(line, " s %d %d %d", &a, &b, &c) == 3)
+            frames.push_back(servo_frame(a, b, c));
+        else if (sscanf(line, " p %lf %lf %d", &x, &y, &c) == 3)
+            frames.push_back(pos_frame(x, y, c));
+        else if (sscanf(line, " k %d %d %d", &a, &b, &c) == 3)
+            frames.push_back(cal_frame(a, b, c));
+        else if (strncmp(line, "k linear", 8) == 0)
+            frames.push_back(cal_frame(0xFF, 0, 0));
+        else if (sscanf(line, " %c", &cmd) == 1 && cmd == 'i')
+        {
+            frames.push_back(Frame{ LINK_ISR, {} });
+            isr_requested = 1;
+        }
+    }
+}
+
+int main(int argc, char **argv)
+{
+    std::vector<Frame> frames;
+    struct termios tio;
+    unsigned long acked = 0, sent = 0, consumed = 0, last_consumed = 0;
+    unsigned resends = 0, underruns = 0, n = 0, i;
+    uint8_t ack = 0, free_slots = 0, rec[sizeof(TraceRecord)];
+    int fd, synced = 0;
+    long t_sent = 0, t_progress, t_stat, t_end = 0;
+
+    if (argc < 2)
+    {
+        fprintf(stderr, "Aufruf: %s <gerät> [datei|-]\n", argv[0]);
+        return 1;
+    }
+    if (argc > 2)
+    {
+        FILE *in = strcmp(argv[2], "-") ? fopen(argv[2], "r") : stdin;
+        if (!in)
+        {
+            perror(argv[2]);
+            return 1;
+        }
+        load(in, frames);
+    }
+    else
+        for (i = 0; i < 10 * 50; i++)
+            frames.push_back(pos_frame(40 + 15 * cos(i * M_PI / 100), 30 + 15 * sin(i * M_PI / 100), DEMO_LIFT));
+    frames.push_back(Frame{ LINK_END, {} });
+
+    if ((fd = open(argv[1], O_RDWR | O_NOCTTY)) < 0)
+    {
+        perror(argv[1]);
+        return 1;
+    }
+    if (tcgetattr(fd, &tio) == 0)
+    {
+        cfmakeraw(&tio);
+        cfsetspeed(&tio, B38400);
+        tcsetattr(fd, TCSANOW, &tio);
+    }
+
+    t_progress = t_stat = now_ms();
+    while (consumed < frames.size() ||
+           (isr_requested && isr_received < ISR_BYTES && now_ms() - t_end < ISR_WAIT_MS))
+    {
+        long t = now_ms();
+        fd_set rd;
+        struct timeval tv = { 0, 5000 };
+
+        /* Folgenummer abgleichen, dann im Rahmen der Gutschrift senden */
+        if (!synced && t - t_sent > 500)
+        {
+            send_frame(fd, 0, Frame{ LINK_SYNC, {} });
+            t_sent = t;
+        }
+        if (synced && sent > acked && t - t_progress > RESEND_MS)
+        {
+            sent = acked;               // go-back-N
+            resends++;
+            t_progress = t;
+        }
+        while (synced && sent < frames.size() && sent < acked + free_slots)
+        {
+            send_frame(fd, (uint8_t)(sent + 1), frames[sent]);
+            sent++;
+        }
+
+        FD_ZERO(&rd);
+        FD_SET(fd, &rd);
+        if (select(fd + 1, &rd, 0, 0, &tv) > 0)
+        {
+            uint8_t buf[256];
+            ssize_t len = read(fd, buf, sizeof(buf));
+
+            for (ssize_t k = 0; k < len; k++)
+            {
+                rec[n++] = buf[k];
+                if ((rec[0] & 0xF0) != TRACE_MARK)
+                {
+                    n = 0;
+                    continue;
+                }
+                if (n < sizeof(rec))
+                    continue;
+                n = 0;
+                if (rec[0] == (TRACE_MARK | TRACE_UNDERRUN))
+                    underruns = rec[2] | (rec[3] << 8);
+                if (rec[0] == (TRACE_MARK | TRACE_ISR) && rec[2] < ISR_BYTES && !isr_got[rec[2]])
+                {
+                    isr_data[rec[2]] = rec[3];
+                    isr_got[rec[2]] = 1;
+                    isr_received++;
+                }
+                if (rec[0] != (TRACE_MARK | TRACE_LINK))
+                    continue;
+                if (!synced)
+                {
+                    if (rec[3] != 0)
+                        continue;       // Meldung vor der Synchronisation
+                    synced = 1;
+                    ack = 0;
+                }
+                acked += (uint8_t)(rec[3] - ack);
+                if (rec[3] != ack)
+                    t_progress = now_ms();
+                ack = rec[3];
+                free_slots = rec[2];
+                if (acked > sent)
+                    acked = sent;       // Quittung aus einem früheren Durchlauf
+                consumed = acked - (LINK_QUEUE - 1 - free_slots);
+                if (consumed >= frames.size() && !t_end)
+                    t_end = now_ms();
+            }
+        }
+
+        if (t - t_stat >= 1000)
+        {
+            printf("%5lu/%zu Zyklen, %3lu/s, %u Fehlzyklen, %u Wiederholungen\n",
+                   consumed, frames.size(), (consumed - last_consumed) * 1000 / (t - t_stat), underruns, resends);
+            last_consumed = consumed;
+            t_stat = t;
+        }
+    }
+    printf("fertig: %zu Zyklen, %u Fehlzyklen, %u Wiederholungen\n", frames.size(), underruns, resends);
+    if (isr_requested)
+        isr_report();
+    return 0;
+}
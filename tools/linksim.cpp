@@ -0,0 +1,206 @@
+/* Gegenstelle für tools/linkhost.cpp ohne Uhr: die Firmwaremodule der
+   Übertragung (link.cpp, trace.cpp, pwm.cpp bis calib.cpp) laufen auf dem
+   PC hinter einem Pseudoterminal. Empfangene Bytes gehen an die
+   Empfangs-ISR, die UDRE-ISR sendet die Protokolleinträge zurück; die
+   Soft-PWM-ISR läuft in Echtzeit einen Zyklus je 20 ms, das EEPROM
+   braucht wie auf dem Controller 8,5 ms je geschriebenem Byte.
+
+   Übersetzen (im Hauptverzeichnis):
+     g++ -O2 -DF_CPU=4000000UL -DTRACE -DLINK -DPWM_WAIT_HOOK=sim_step \
+         -DSIM_EEPROM_CLOCK=sim_clock_us \
+         -Itools/plotsim -I. -o linksim tools/linksim.cpp link.cpp \
+         trace.cpp ticks.cpp pwm.cpp servo.cpp calib.cpp stats.cpp kinematics.cpp
+   Mit -DISR_STATS (und isrstat.cpp) beantwortet es auch LINK_ISR, z. B.
+   eine Zeile "i" für linkhost. Auf dem PC steht Timer1 während einer ISR
+   still: Laufzeiten und Latenzen sind dort 0, Aufrufzahlen, Klassen und
+   Übertragung stimmen; Zeiten liefert die Uhr mit derselben Anforderung.
+   Aufruf:
+     ./linksim [-l n]          jedes n-te empfangene Byte verwerfen
+   Das Programm nennt das Pseudoterminal (z. B. /dev/pts/5); dort dann
+     ./linkhost /dev/pts/5 [datei|-]
+   Nach dem Ende der Übertragung (LINK_END oder LINK_TIMEOUT) läuft noch
+   eine Sekunde Leerlauf (link_poll, cal_idle), dann gibt es die Zähler (link_stats)
+   und die im EEPROM gespeicherten Kennlinien aus und beendet sich. */
+#define _XOPEN_SOURCE 600
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+#include <sys/time.h>
+#include <avr/interrupt.h>
+#include "pwm.h"
+#include "servo.h"
+#include "calib.h"
+#include "trace.h"
+#include "ticks.h"
+#include "link.h"
+#include "isrstat.h"
+
+#define SIM_DEFINE8(r)      volatile uint8_t r;
+#define SIM_DEFINE16(r)     volatile uint16_t r;
+SIM_REGISTERS(SIM_DEFINE8, SIM_DEFINE16)
+
+extern "C" void TIMER1_COMPA_vect(void);
+extern "C" void USART_RXC_vect(void);
+extern "C" void USART_UDRE_vect(void);
+void sim_step(void);
+
+#define FRAME_US    20000L              // PWM-Zyklus in Echtzeit
+
+static int pty = -1;
+static long loss;                       // jedes loss-te Byte verwerfen, 0 = keines
+static long received, dropped;
+static long next_frame;                 // Echtzeit des nächsten Zyklusendes [µs]
+static long start;
+
+static long now_us(void)
+{
+    struct timeval tv;
+
+    gettimeofday(&tv, 0);
+    return tv.tv_sec * 1000000L + tv.tv_usec;
+}
+
+/* Uhr des EEPROM-Modells (SIM_EEPROM_CLOCK) */
+long sim_clock_us(void)
+{
+    return now_us();
+}
+
+/* ISR wie auf dem Controller mit gesperrten Interrupts aufrufen */
+static void interrupt(void (*vector)(void))
+{
+    SREG &= ~(1 << SREG_I);
+    vector();
+    SREG |= (1 << SREG_I);
+}
+
+/* Zeitbasis für trace (ticks_now): Timer2 aus der Echtzeit */
+static void sim_ticks(void)
+{
+    long t = (now_us() - start) * TICKS_PER_SECOND / 1000000L;
+
+    tick_overflows = t >> 8;
+    TCNT2 = (uint8_t)t;
+}
+
+/* Empfangene Bytes an die Empfangs-ISR, Protokolleinträge senden */
+static void sim_serial(void)
+{
+    uint8_t buf[64], out[256];
+    ssize_t len, k;
+    size_t n = 0;
+
+    while ((len = read(pty, buf, sizeof(buf))) > 0)
+    {
+        for (k = 0; k < len; k++)
+        {
+            if (++received, loss && received % loss == 0)
+            {
+                dropped++;
+                continue;
+            }
+            UCSRA = 0;
+            UDR = buf[k];
+            if (UCSRB & (1 << RXCIE))
+                interrupt(USART_RXC_vect);
+        }
+    }
+    sim_ticks();
+    while ((UCSRB & (1 << UDRIE)) && n < sizeof(out))
+    {
+        interrupt(USART_UDRE_vect);
+        if (UCSRB & (1 << UDRIE))
+            out[n++] = UDR;
+    }
+    if (n && write(pty, out, n) != (ssize_t)n)
+        perror("write");
+}
+
+/* Warten auf das Zyklusende (PWM_WAIT_HOOK): bis zur Echtzeit des nächsten
+   Zyklus die Schnittstelle bedienen, dann den Zyklus ausgeben */
+void sim_step(void)
+{
+    uint16_t frames = pwm_frames;
+
+    while (now_us() < next_frame)
+    {
+        sim_serial();
+        usleep(500);
+    }
+    next_frame += FRAME_US;
+    if (now_us() > next_frame)
+        next_frame = now_us() + FRAME_US;   // nach Verzug nicht aufholen
+    while (pwm_frames == frames && (TIMSK & (1 << OCIE1A)))
+    {
+        TCNT1 = OCR1A;
+        interrupt(TIMER1_COMPA_vect);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    struct termios tio;
+
+    if (argc > 2 && strcmp(argv[1], "-l") == 0)
+        loss = atol(argv[2]);
+
+    if ((pty = posix_openpt(O_RDWR | O_NOCTTY)) < 0 || grantpt(pty) || unlockpt(pty))
+    {
+        perror("posix_openpt");
+        return 1;
+    }
+    if (tcgetattr(pty, &tio) == 0)
+    {
+        cfmakeraw(&tio);
+        tcsetattr(pty, TCSANOW, &tio);
+    }
+    fcntl(pty, F_SETFL, O_NONBLOCK);
+    printf("%s\n", ptsname(pty));
+    fflush(stdout);
+
+    start = now_us();
+    next_frame = start + FRAME_US;
+    sei();
+#ifdef ISR_STATS
+    isr_stats_init();
+#endif
+    trace_init();
+    cal_load();
+    servo_init();
+    pwm_init();
+    link_enable(1);
+
+    /* wie MODE_IDLE und MODE_STREAM in main.cpp */
+    while (!link_poll())
+    {
+        sim_serial();
+        cal_idle();
+        usleep(1000);
+    }
+    while (link_run())
+        sim_serial();
+    pwm_off();
+    link_poll();                        // wie MODE_IDLE: Stand nach LINK_END melden
+    for (long end = now_us() + 1000000L; now_us() < end; )
+    {
+        link_poll();                    // wie MODE_IDLE (ISR-Statistik)
+        sim_serial();                   // letzte Meldungen abholen lassen
+        cal_idle();
+        usleep(1000);
+    }
+
+    printf("%u Sätze, %u Fehlzyklen, %u verworfene Rahmen, %ld von %ld Byte verworfen\n",
+           link_stats.frames, link_stats.underruns, link_stats.errors, dropped, received);
+    cal_load();                         // wie nach einem Neustart
+    for (uint8_t ch = 0; ch < SERVO_COUNT; ch++)
+    {
+        printf("Kennlinie %u:", ch);
+        for (uint8_t k = 0; k < CAL_KNOTS; k++)
+            printf(" %u", cal_get(ch, k));
+        printf(" µs\n");
+    }
+    return 0;
+}
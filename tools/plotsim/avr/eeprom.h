@@ -0,0 +1,44 @@
+/* Ersatz für <avr/eeprom.h>: EEPROM im SRAM, beim Start leer (alle Abbilder ungültig) */
+#ifndef SIM_AVR_EEPROM_H
+#define SIM_AVR_EEPROM_H
+
+#include <stdint.h>
+#include <string.h>
+
+#define EEMEM
+
+/* Schreibdauer: mit -DSIM_EEPROM_CLOCK=f (long f(void), Zeit in µs) ist das
+   EEPROM nach jedem geschriebenen Byte wie auf dem Controller 8,5 ms
+   belegt, sonst immer sofort bereit */
+#ifdef SIM_EEPROM_CLOCK
+#define SIM_EEPROM_WRITE_US 8500L
+long SIM_EEPROM_CLOCK(void);
+static long sim_eeprom_busy;
+static inline uint8_t eeprom_is_ready(void) { return SIM_EEPROM_CLOCK() >= sim_eeprom_busy; }
+static inline void eeprom_write_byte(uint8_t *p, uint8_t v)
+{
+    while (!eeprom_is_ready());
+    *p = v;
+    sim_eeprom_busy = SIM_EEPROM_CLOCK() + SIM_EEPROM_WRITE_US;
+}
+#else
+static inline uint8_t eeprom_is_ready(void) { return 1; }
+static inline void eeprom_write_byte(uint8_t *p, uint8_t v) { *p = v; }
+#endif
+
+static inline uint8_t eeprom_read_byte(const uint8_t *p) { return *p; }
+static inline uint16_t eeprom_read_word(const uint16_t *p) { return *p; }
+static inline void eeprom_read_block(void *dst, const void *src, size_t n) { memcpy(dst, src, n); }
+static inline void eeprom_update_byte(uint8_t *p, uint8_t v) { if (*p != v) eeprom_write_byte(p, v); }
+static inline void eeprom_update_word(uint16_t *p, uint16_t v)
+{
+    eeprom_update_byte((uint8_t *)p, (uint8_t)v);
+    eeprom_update_byte((uint8_t *)p + 1, v >> 8);
+}
+static inline void eeprom_update_block(const void *src, void *dst, size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+        eeprom_update_byte((uint8_t *)dst + i, ((const uint8_t *)src)[i]);
+}
+
+#endif // SIM_AVR_EEPROM_H
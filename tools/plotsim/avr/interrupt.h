@@ -0,0 +1,11 @@
+/* Ersatz für <avr/interrupt.h>: ISRs werden vom Simulator direkt aufgerufen */
+#ifndef SIM_AVR_INTERRUPT_H
+#define SIM_AVR_INTERRUPT_H
+
+#include <avr/io.h>
+
+#define ISR(vector)     extern "C" void vector(void)
+#define sei()           (SREG |= (1 << SREG_I))
+#define cli()           (SREG &= ~(1 << SREG_I))
+
+#endif // SIM_AVR_INTERRUPT_H
@@ -0,0 +1,59 @@
+/* Ersatz für <avr/io.h> im Simulator: die benutzten Register des ATmega8
+   als gewöhnliche Variablen (definiert in plotsim.cpp) */
+#ifndef SIM_AVR_IO_H
+#define SIM_AVR_IO_H
+
+#include <stdint.h>
+
+#define SIM_REGISTERS(R8, R16) \
+    R8(PORTB) R8(PORTC) R8(PORTD) R8(DDRB) R8(DDRC) R8(DDRD) R8(PINB) R8(PINC) R8(PIND) \
+    R8(TCCR0) R8(TCNT0) R8(TIFR) R8(TIMSK) R8(TCCR1A) R8(TCCR1B) \
+    R16(OCR1A) R16(OCR1B) R16(TCNT1) \
+    R8(TCCR2) R8(TCNT2) R8(OCR2) R8(ASSR) R8(ACSR) R8(SFIOR) R8(MCUCR) R8(GICR) \
+    R8(UBRRH) R8(UBRRL) R8(UCSRA) R8(UCSRB) R8(UCSRC) R8(UDR) R8(SREG)
+
+#define SIM_DECLARE8(r)     extern volatile uint8_t r;
+#define SIM_DECLARE16(r)    extern volatile uint16_t r;
+SIM_REGISTERS(SIM_DECLARE8, SIM_DECLARE16)
+
+/* Bitnummern */
+#define TOV0    0
+#define TOIE0   0
+#define CS00    0
+#define CS01    1
+#define CS02    2
+#define OCF1B   3
+#define OCF1A   4
+#define OCIE1B  3
+#define OCIE1A  4
+#define TOIE1   2
+#define TOV1    2
+#define CS10    0
+#define CS11    1
+#define CS12    2
+#define TCR2UB  0
+#define OCR2UB  1
+#define TCN2UB  2
+#define AS2     3
+#define CS20    0
+#define CS21    1
+#define CS22    2
+#define TOV2    6
+#define TOIE2   6
+#define ACD     7
+#define PUD     2
+#define U2X     1
+#define DOR     3
+#define FE      4
+#define UDRE    5
+#define RXC     7
+#define UCSZ0   1
+#define UCSZ1   2
+#define TXEN    3
+#define RXEN    4
+#define UDRIE   5
+#define RXCIE   7
+#define URSEL   7
+#define SREG_I  7
+
+#endif // SIM_AVR_IO_H
@@ -0,0 +1,345 @@
+/* Plotter-Simulator für den PC: lässt den Zeichenablauf der Firmware
+   (plot.cpp bis pwm.cpp) für eine Folge von Minutenwechseln laufen. Die
+   Soft-PWM-ISR wird dabei mit simuliertem Timer1 aufgerufen; aus den
+   Flanken an den PWM-Pins (PWM_PINS) werden die Pulsbreiten gewonnen.
+   Ein Servomodell mit begrenzter Stellgeschwindigkeit (wie
+   SERVO_TRAVEL_US_PER_DEG) folgt den Pulsen, die Vorwärtskinematik der
+   beiden Arme liefert daraus die Stiftbahn.
+
+   Ausgabe je Minute: Zeichendauer, Weg mit abgehobenem Stift und die
+   Abweichung der gezeichneten Bahn von der kommandierten (Servoverzug).
+   Die Bahnen werden als SVG gezeichnet, mit Zeitmarken je Sekunde.
+
+   Übersetzen (im Hauptverzeichnis):
+     g++ -O2 -DF_CPU=4000000UL -DPWM_WAIT_HOOK=sim_step -Itools/plotsim -I. \
+         -o plotsim tools/plotsim/plotsim.cpp pwm.cpp servo.cpp calib.cpp \
+         stats.cpp motion.cpp kinematics.cpp plot.cpp glyph.cpp stroke.cpp
+   Aufruf:
+     ./plotsim [-o datei.svg] [HH:MM [minuten]]      (Vorgabe 12:58, 4 Minuten) */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <vector>
+#include "pwm.h"
+#include "servo.h"
+#include "calib.h"
+#include "motion.h"
+#include "plot.h"
+#include "kinematics.h"
+
+#define SIM_DEFINE8(r)      volatile uint8_t r;
+#define SIM_DEFINE16(r)     volatile uint16_t r;
+SIM_REGISTERS(SIM_DEFINE8, SIM_DEFINE16)
+
+extern "C" void TIMER1_COMPA_vect(void);
+void sim_step(void);
+
+#define TICK_US         (PWM_PRESCALER * 1e6 / F_CPU)  // Timer1-Takt [µs]
+#define US_PER_DEG      ((double)(MAX_PULSE_WIDTH - MIN_PULSE_WIDTH) / 180)
+#define SLEW            (US_PER_DEG / SERVO_TRAVEL_US_PER_DEG)  // Pulsänderung je µs Zeit
+#define PEN_DOWN_US     (MIN_PULSE_WIDTH + US_PER_DEG * (MOTION_LIFT_DRAW + MOTION_LIFT_UP) / 2)
+#define MM(v)           ((v) / 16.0)    // 1/16 mm -> mm
+#define SVG_SCALE       4               // Pixel je mm
+#define SVG_COLUMNS     3
+
+struct Point
+{
+    double x, y;
+};
+
+struct Sample
+{
+    Point pen;
+    uint8_t down;
+    double t;                           // [s] seit Beginn der Minute
+};
+
+struct Minute
+{
+    uint8_t hours, minutes;
+    double seconds;                     // Zeichendauer
+    double penup, pendown;              // Wege [mm]
+    double dev_max, dev_sum;            // Abweichung [mm] (Stift unten)
+    unsigned dev_count;
+    std::vector<Sample> trace;
+};
+
+static const uint8_t pins[PWM_CHANNELS] = PWM_PINS;
+static volatile uint8_t *const ports[PWM_PORTS] = { &PORTB, &PORTC, &PORTD };
+
+static uint64_t sim_ticks;              // simulierte Zeit [Timer1-Takte]
+static uint64_t rise[PWM_CHANNELS];
+static uint8_t level[PWM_CHANNELS];
+static double cmd_us[PWM_CHANNELS];     // zuletzt gemessene Pulsbreite
+static double act_us[PWM_CHANNELS];     // Stellung laut Servomodell (als Pulsbreite)
+static uint8_t seen[PWM_CHANNELS];
+static uint16_t last_frames;
+static uint64_t minute_start;
+static Point last_pen = { MM(PLOT_PARK_X), MM(PLOT_PARK_Y) };
+static Minute *cur;
+
+/* Schnittpunkte zweier Kreise; Rückgabe 0, wenn sie sich nicht schneiden */
+static int circles(Point a, double ra, Point b, double rb, Point *p1, Point *p2)
+{
+    double dx = b.x - a.x, dy = b.y - a.y;
+    double d = hypot(dx, dy);
+    double l, h;
+
+    if (d == 0 || d > ra + rb || d < fabs(ra - rb))
+        return 0;
+    l = (ra * ra - rb * rb + d * d) / (2 * d);
+    h = sqrt(fmax(ra * ra - l * l, 0));
+    p1->x = a.x + (l * dx - h * dy) / d;
+    p1->y = a.y + (l * dy + h * dx) / d;
+    p2->x = a.x + (l * dx + h * dy) / d;
+    p2->y = a.y + (l * dy - h * dx) / d;
+    return 1;
+}
+
+/* Vorwärtskinematik (Umkehrung von kin_inverse): Pulsbreiten -> Stift.
+   Der linke Unterarm ist starr: Gelenk E1, Stift P und Gelenkpunkt H des
+   rechten Unterarms, Winkel E1-P-H = 569/16 Grad. Von den möglichen
+   Lösungen gilt die nächste zur vorherigen Stiftposition */
+static Point forward(double left_us, double right_us, Point near)
+{
+    const double L1 = MM(KIN_L1), L2 = MM(KIN_L2), L3 = MM(KIN_L3), L4 = MM(KIN_L4);
+    const double gamma = 569 / 16.0 * M_PI / 180;
+    double t1 = (left_us - KIN_LEFT_NULL_US) / KIN_US_PER_RAD + M_PI;
+    double t2 = (right_us - KIN_RIGHT_NULL_US) / KIN_US_PER_RAD;
+    Point e1 = { MM(KIN_O1X) + L1 * cos(t1), MM(KIN_O1Y) + L1 * sin(t1) };
+    Point e2 = { MM(KIN_O2X) + L1 * cos(t2), MM(KIN_O2Y) + L1 * sin(t2) };
+    double d = sqrt(L2 * L2 + L3 * L3 - 2 * L2 * L3 * cos(gamma));
+    Point h[2], p[2], best = near;
+    double best_dist = 1e9;
+    int i, j;
+
+    if (!circles(e1, d, e2, L4, &h[0], &h[1]))
+        return near;
+    for (i = 0; i < 2; i++)
+    {
+        if (!circles(e1, L2, h[i], L3, &p[0], &p[1]))
+            continue;
+        for (j = 0; j < 2; j++)
+        {
+            /* Drehsinn P->E1 nach P->H wie in kin_inverse (positiv) */
+            double cross = (e1.x - p[j].x) * (h[i].y - p[j].y) - (e1.y - p[j].y) * (h[i].x - p[j].x);
+            double dist = hypot(p[j].x - near.x, p[j].y - near.y);
+
+            if (cross > 0 && dist < best_dist)
+            {
+                best = p[j];
+                best_dist = dist;
+            }
+        }
+    }
+    return best;
+}
+
+/* Servomodell: bewegt sich mit begrenzter Geschwindigkeit auf den Puls zu */
+static void advance(uint16_t ticks)
+{
+    double step = ticks * TICK_US * SLEW;
+    uint8_t ch;
+
+    for (ch = 0; ch < PWM_CHANNELS; ch++)
+    {
+        double diff = cmd_us[ch] - act_us[ch];
+
+        act_us[ch] += (diff > step) ? step : (diff < -step) ? -step : diff;
+    }
+    sim_ticks += ticks;
+}
+
+/* Flanken an den PWM-Pins auswerten */
+static void sample_ports(void)
+{
+    uint8_t ch, on;
+
+    for (ch = 0; ch < PWM_CHANNELS; ch++)
+    {
+        on = (*ports[pins[ch] >> 3] >> (pins[ch] & 7)) & 1;
+        if (on && !level[ch])
+            rise[ch] = sim_ticks;
+        else if (!on && level[ch])
+        {
+            cmd_us[ch] = (sim_ticks - rise[ch]) * TICK_US;
+            if (!seen[ch])
+                act_us[ch] = cmd_us[ch];    // Ausgangslage unbekannt: sofort dort
+            seen[ch] = 1;
+        }
+        level[ch] = on;
+    }
+}
+
+/* Am Ende jedes PWM-Zyklus: Stiftposition aufzeichnen und auswerten */
+static void sample_pen(void)
+{
+    Sample s;
+    Point ideal;
+
+    if (!cur || !seen[SERVO_LEFT] || !seen[SERVO_RIGHT])
+        return;
+    s.pen = forward(act_us[SERVO_LEFT], act_us[SERVO_RIGHT], last_pen);
+    s.down = act_us[SERVO_LIFT] > PEN_DOWN_US;
+    s.t = (sim_ticks - minute_start) * TICK_US / 1e6;
+    if (s.down)
+    {
+        double dev;
+
+        ideal = forward(cmd_us[SERVO_LEFT], cmd_us[SERVO_RIGHT], s.pen);
+        dev = hypot(ideal.x - s.pen.x, ideal.y - s.pen.y);
+        cur->dev_sum += dev;
+        cur->dev_count++;
+        if (dev > cur->dev_max)
+            cur->dev_max = dev;
+        cur->pendown += hypot(s.pen.x - last_pen.x, s.pen.y - last_pen.y);
+    }
+    else
+        cur->penup += hypot(s.pen.x - last_pen.x, s.pen.y - last_pen.y);
+    last_pen = s.pen;
+    cur->trace.push_back(s);
+}
+
+/* Timer1 bis zum nächsten Compare-Zeitpunkt laufen lassen (PWM_WAIT_HOOK) */
+void sim_step(void)
+{
+    uint16_t due = OCR1A;
+
+    if (!(TIMSK & (1 << OCIE1A)))
+    {
+        fprintf(stderr, "plotsim: Warten auf einen Zyklus bei angehaltener PWM\n");
+        exit(1);
+    }
+    advance((uint16_t)(due - TCNT1));
+    TCNT1 = due;
+    TIMER1_COMPA_vect();
+    sample_ports();
+    if (pwm_frames != last_frames)
+    {
+        last_frames = pwm_frames;
+        sample_pen();
+    }
+}
+
+static void draw_minute(Minute *m)
+{
+    uint8_t i;
+
+    cur = m;
+    minute_start = sim_ticks;
+    for (i = 0; i < 100; i++)           // Leerlauf der Vorminute
+        plot_prepare(m->hours, m->minutes);
+    plot_begin(m->hours, m->minutes);
+    while (plot_run());
+    pwm_off();
+    while (TIMSK & (1 << OCIE1A))       // bis die ISR Timer1 anhält
+        sim_step();
+    m->seconds = (sim_ticks - minute_start) * TICK_US / 1e6;
+    cur = 0;
+}
+
+static void write_svg(const char *name, const std::vector<Minute> &list)
+{
+    double x0 = 1e9, y0 = 1e9, x1 = -1e9, y1 = -1e9, w, h;
+    FILE *f = fopen(name, "w");
+    size_t n, k;
+
+    if (!f)
+    {
+        perror(name);
+        return;
+    }
+    for (n = 0; n < list.size(); n++)
+        for (k = 0; k < list[n].trace.size(); k++)
+        {
+            const Point &p = list[n].trace[k].pen;
+            x0 = fmin(x0, p.x); x1 = fmax(x1, p.x);
+            y0 = fmin(y0, p.y); y1 = fmax(y1, p.y);
+        }
+    x0 -= 5; y0 -= 5; x1 += 5; y1 += 15;    // Rand, oben Platz für die Überschrift
+    w = (x1 - x0) * SVG_SCALE;
+    h = (y1 - y0) * SVG_SCALE;
+
+    fprintf(f, "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"%.0f\" height=\"%.0f\" font-family=\"sans-serif\">\n",
+            w * SVG_COLUMNS, h * ((list.size() + SVG_COLUMNS - 1) / SVG_COLUMNS));
+    for (n = 0; n < list.size(); n++)
+    {
+        const Minute &m = list[n];
+        double ox = (n % SVG_COLUMNS) * w, oy = (n / SVG_COLUMNS) * h;
+        int second = 1;
+
+        fprintf(f, "<g transform=\"translate(%.1f,%.1f)\">\n", ox, oy);
+        fprintf(f, "<rect width=\"%.1f\" height=\"%.1f\" fill=\"none\" stroke=\"#ccc\"/>\n", w, h);
+        fprintf(f, "<text x=\"6\" y=\"16\" font-size=\"13\">%02u:%02u  %.1f s, Stift oben %.0f mm, "
+                "Abweichung max %.2f mm</text>\n", m.hours, m.minutes, m.seconds, m.penup, m.dev_max);
+        for (k = 1; k < m.trace.size(); k++)
+        {
+            const Sample &a = m.trace[k - 1], &b = m.trace[k];
+
+            fprintf(f, "<line x1=\"%.2f\" y1=\"%.2f\" x2=\"%.2f\" y2=\"%.2f\" %s/>\n",
+                    (a.pen.x - x0) * SVG_SCALE, (y1 - a.pen.y) * SVG_SCALE,
+                    (b.pen.x - x0) * SVG_SCALE, (y1 - b.pen.y) * SVG_SCALE,
+                    b.down ? "stroke=\"black\" stroke-width=\"1.6\""
+                           : "stroke=\"#999\" stroke-width=\"0.6\" stroke-dasharray=\"3,2\"");
+            if (b.t >= second)
+            {
+                fprintf(f, "<circle cx=\"%.2f\" cy=\"%.2f\" r=\"2\" fill=\"#c00\"/>"
+                        "<text x=\"%.2f\" y=\"%.2f\" font-size=\"9\" fill=\"#c00\">%d s</text>\n",
+                        (b.pen.x - x0) * SVG_SCALE, (y1 - b.pen.y) * SVG_SCALE,
+                        (b.pen.x - x0) * SVG_SCALE + 3, (y1 - b.pen.y) * SVG_SCALE - 3, second);
+                second++;
+            }
+        }
+        fprintf(f, "</g>\n");
+    }
+    fprintf(f, "</svg>\n");
+    fclose(f);
+}
+
+int main(int argc, char **argv)
+{
+    const char *svg = "plotsim.svg";
+    unsigned hours = 12, minutes = 58, count = 4, i;
+    std::vector<Minute> list;
+    double total = 0, penup = 0;
+    int a = 1;
+
+    if (a + 1 < argc && !strcmp(argv[a], "-o"))
+    {
+        svg = argv[a + 1];
+        a += 2;
+    }
+    if (a < argc && sscanf(argv[a++], "%u:%u", &hours, &minutes) != 2)
+    {
+        fprintf(stderr, "Aufruf: %s [-o datei.svg] [HH:MM [minuten]]\n", argv[0]);
+        return 1;
+    }
+    if (a < argc)
+        count = atoi(argv[a]);
+
+    SREG = 1 << SREG_I;
+    pwm_init();
+    cal_load();
+    servo_init();
+    plot_init();
+    pwm_off();
+
+    list.resize(count);
+    printf("Zeit   Dauer[s] Stift oben[mm] Stift unten[mm] Abw. max/mittel[mm]\n");
+    for (i = 0; i < count; i++)
+    {
+        Minute &m = list[i];
+
+        m.hours = (hours + (minutes + i) / 60) % 24;
+        m.minutes = (minutes + i) % 60;
+        draw_minute(&m);
+        printf("%02u:%02u  %8.2f %14.1f %15.1f %10.2f/%.2f\n", m.hours, m.minutes, m.seconds,
+               m.penup, m.pendown, m.dev_max, m.dev_count ? m.dev_sum / m.dev_count : 0.0);
+        total += m.seconds;
+        penup += m.penup;
+    }
+    printf("Summe  %8.2f %14.1f\n", total, penup);
+    write_svg(svg, list);
+    return 0;
+}
@@ -0,0 +1,9 @@
+/* Ersatz für <util/atomic.h>: der Simulator läuft in einem Faden */
+#ifndef SIM_UTIL_ATOMIC_H
+#define SIM_UTIL_ATOMIC_H
+
+#define ATOMIC_BLOCK(type)      for (uint8_t sim_atomic = 1; sim_atomic; sim_atomic = 0)
+#define ATOMIC_RESTORESTATE
+#define ATOMIC_FORCEON
+
+#endif // SIM_UTIL_ATOMIC_H
@@ -0,0 +1,8 @@
+/* Ersatz für <util/delay.h>: Wartezeiten entfallen im Simulator */
+#ifndef SIM_UTIL_DELAY_H
+#define SIM_UTIL_DELAY_H
+
+#define _delay_ms(ms)
+#define _delay_us(us)
+
+#endif // SIM_UTIL_DELAY_H
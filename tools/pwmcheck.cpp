@@ -0,0 +1,352 @@
+/* Prüfstand für pwm_update() auf dem PC: die Flanken, die die Soft-PWM-ISR
+   (TIMER1_COMPA_vect) mit simuliertem Timer1 tatsächlich ausgibt, werden
+   mit einem einfachen Modell verglichen: ein Kanal mit Wert v > 0 ist zu
+   Beginn jedes Zyklus v * T_PWM Takte an, mit 0 bleibt er aus; ein Zyklus
+   dauert PWM_STEPS * T_PWM Takte, bei allen Kanälen 0 hält Timer1 an.
+
+   Geprüft wird Flanke für Flanke: Zeitpunkt jedes ISR-Aufrufs und welche
+   Kanäle er umschaltet (Flanke 0 schaltet genau die Kanäle > 0 an, jede
+   weitere genau die Kanäle eines Werts aus, keine leeren oder doppelten
+   Flanken), dazu die Übergabe: ein neuer Satz gilt erst ab dem nächsten
+   Zyklusanfang, und ein noch nicht übernommener Satz wird vom jüngeren
+   ersetzt.
+
+   Eingaben: alle PWM_STEPS^PWM_CHANNELS Kombinationen (bei 3 Kanälen
+   16,7 Mio., wenige Sekunden), danach Zufallsfolgen mit Nullen,
+   Duplikaten, Randwerten (1, PWM_STEPS-1), kleinen Änderungen wie beim
+   Zeichnen und Aktualisierungen mitten im Zyklus.
+
+   Zeitmessung: Mittel je Aufruf von pwm_update() für typische Folgen, in
+   ns auf dem PC (nur zum Vergleich von Fassungen; Takte auf dem AVR
+   liefert der Messlauf in bench.h).
+
+   Übersetzen (im Hauptverzeichnis; für eine andere Fassung von
+   pwm_update() deren Datei statt pwm.cpp angeben):
+     g++ -O2 -DF_CPU=4000000UL -Itools/plotsim -I. -o pwmcheck \
+         tools/pwmcheck.cpp pwm.cpp
+   Aufruf:
+     ./pwmcheck [-q] [zufallsfolgen]    (-q: ohne vollständige Aufzählung,
+                                         Vorgabe 200000 Zufallsfolgen)
+   Rückgabe 1 bei Abweichungen. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include "pwm.h"
+
+#define SIM_DEFINE8(r)      volatile uint8_t r;
+#define SIM_DEFINE16(r)     volatile uint16_t r;
+SIM_REGISTERS(SIM_DEFINE8, SIM_DEFINE16)
+
+extern "C" void TIMER1_COMPA_vect(void);
+
+#define CYCLE           ((uint32_t)T_PWM * PWM_STEPS)
+#define REPORT_MAX      10              // ausführlich gemeldete Abweichungen
+
+static const uint8_t pins[PWM_CHANNELS] = PWM_PINS;
+static volatile uint8_t *const ports[PWM_PORTS] = { &PORTB, &PORTC, &PORTD };
+
+static uint64_t now;                    // simulierte Zeit [Timer1-Takte]
+static uint8_t active[PWM_CHANNELS];    // Einstellung des laufenden bzw. nächsten Zyklus
+static uint8_t published[PWM_CHANNELS]; // zuletzt veröffentlicht
+static uint8_t pending;                 // published noch nicht übernommen
+static unsigned long failures;
+static unsigned long cycles;
+
+/* Kanäle, deren Pin gerade an ist (Bit = Kanalnummer) */
+static uint16_t levels(void)
+{
+    uint16_t on = 0;
+    uint8_t ch;
+
+    for (ch = 0; ch < PWM_CHANNELS; ch++)
+        if ((*ports[pins[ch] >> 3] >> (pins[ch] & 7)) & 1)
+            on |= 1 << ch;
+    return on;
+}
+
+/* Kanäle mit Wert größer als v */
+static uint16_t above(const uint8_t *val, uint16_t v)
+{
+    uint16_t on = 0;
+    uint8_t ch;
+
+    for (ch = 0; ch < PWM_CHANNELS; ch++)
+        if (val[ch] > v)
+            on |= 1 << ch;
+    return on;
+}
+
+static int running(void)
+{
+    return (TIMSK & (1 << OCIE1A)) && TCCR1B;
+}
+
+/* Timer1 bis zum nächsten Compare-Zeitpunkt laufen lassen, ISR aufrufen */
+static void step(void)
+{
+    uint16_t due = OCR1A;
+
+    now += (uint16_t)(due - TCNT1);
+    TCNT1 = due;
+    TIMER1_COMPA_vect();
+}
+
+static void fail(const uint8_t *val, const char *what, unsigned long got, unsigned long want)
+{
+    uint8_t ch;
+
+    if (failures++ >= REPORT_MAX)
+        return;
+    printf("FEHLER bei {");
+    for (ch = 0; ch < PWM_CHANNELS; ch++)
+        printf(ch ? ", %u" : "%u", val[ch]);
+    printf("}: %s ist %lu, erwartet %lu\n", what, got, want);
+}
+
+static int all_zero(const uint8_t *val)
+{
+    return above(val, 0) == 0;
+}
+
+static int running(void);
+
+/* Veröffentlichen; aus dem Stillstand beginnt sofort ein Zyklus damit */
+static void update(const uint8_t *val)
+{
+    uint8_t was = running();
+
+    memcpy(pwm_setting, val, PWM_CHANNELS);
+    pwm_update();
+    memcpy(published, val, PWM_CHANNELS);
+    pending = 1;
+    if (!was)
+    {
+        memcpy(active, val, PWM_CHANNELS);
+        pending = 0;
+    }
+}
+
+/* Einen vollständigen Zyklus ab Flanke 0 gegen das Modell prüfen (Einstellung
+   active). Vor Löschflanke inject (0 = keine) wird next veröffentlicht. Die
+   ISR übernimmt an der letzten Löschflanke den jüngsten Satz; danach
+   Veröffentlichtes gilt erst ab dem übernächsten Zyklus und kann bis dahin
+   noch von einem jüngeren ersetzt werden */
+static void check_cycle(uint8_t inject, const uint8_t *next)
+{
+    uint8_t val[PWM_CHANNELS];
+    uint16_t frames = pwm_frames;
+    uint16_t prev = 0, v, ch, edge = 0;
+    uint64_t start;
+
+    memcpy(val, active, PWM_CHANNELS);
+    cycles++;
+    if (levels() != 0)
+        fail(val, "Pegel vor Flanke 0", levels(), 0);
+    step();
+    start = now;
+    if (levels() != above(val, 0))
+        fail(val, "Pegel nach Flanke 0", levels(), above(val, 0));
+
+    /* Löschflanken: je verschiedenem Wert > 0 genau eine, aufsteigend */
+    for (;;)
+    {
+        v = PWM_STEPS;
+        for (ch = 0; ch < PWM_CHANNELS; ch++)
+            if (val[ch] > prev && val[ch] < v)
+                v = val[ch];
+        if (v == PWM_STEPS)
+            break;
+        if (++edge == inject)
+            update(next);
+        step();
+        prev = v;
+        if (now - start != (uint64_t)v * T_PWM)
+            fail(val, "Zeitpunkt einer Löschflanke", (unsigned long)(now - start), (unsigned long)v * T_PWM);
+        if (levels() != above(val, v))
+            fail(val, "Pegel nach einer Löschflanke", levels(), above(val, v));
+    }
+    if ((uint16_t)(pwm_frames - frames) != 1)
+        fail(val, "Zyklen je Durchlauf", (uint16_t)(pwm_frames - frames), 1);
+    if (pending)
+        memcpy(active, published, PWM_CHANNELS);
+    pending = 0;
+    if (inject > edge)
+        update(next);   // nach der letzten Flanke: der folgende Zyklus ist schon übernommen
+
+    /* Zyklusende: weiter mit Flanke 0 nach PWM_STEPS Schritten oder angehalten */
+    if (all_zero(active))
+    {
+        if (running())
+            fail(val, "Timer1 läuft nach Zyklus mit allen Kanälen 0", 1, 0);
+        if (levels() != 0)
+            fail(val, "Pegel nach dem Anhalten", levels(), 0);
+    }
+    else if (!running())
+        fail(val, "Timer1 angehalten, obwohl Kanäle > 0", 0, 1);
+    else if (now - start + (uint16_t)(OCR1A - TCNT1) != CYCLE)
+        fail(val, "Zyklusdauer", (unsigned long)(now - start + (uint16_t)(OCR1A - TCNT1)), CYCLE);
+}
+
+/* Neue Einstellung am Zyklusende veröffentlichen und bis zu ihrem ersten
+   Zyklus (einschließlich) prüfen; inject siehe check_cycle() */
+static void transition(const uint8_t *val, uint8_t inject, const uint8_t *next)
+{
+    if (!running())
+    {
+        /* Aus dem Stillstand: sofort mit Flanke 0 der neuen Einstellung */
+        update(val);
+        if (all_zero(val))
+        {
+            if (running() || levels() != 0)
+                fail(val, "Start mit allen Kanälen 0", running(), 0);
+            return;
+        }
+        if ((uint16_t)(OCR1A - TCNT1) != T_PWM)
+            fail(val, "erste Flanke nach dem Start", (uint16_t)(OCR1A - TCNT1), T_PWM);
+        check_cycle(inject, next);
+        return;
+    }
+    /* Der nächste Zyklus ist schon übernommen und läuft noch mit der alten
+       Einstellung, die neue gilt ab dem übernächsten */
+    update(val);
+    check_cycle(0, NULL);
+    if (running())
+        check_cycle(inject, next);
+}
+
+/* Zufallswert mit gehäuften Rand- und Sonderfällen */
+static uint8_t pick(const uint8_t *val, uint8_t ch)
+{
+    int r = rand() % 100;
+
+    if (r < 15)
+        return 0;
+    if (r < 25)
+        return PWM_STEPS - 1;
+    if (r < 30)
+        return 1;
+    if (r < 50 && ch > 0)
+        return val[rand() % ch];        // Duplikat
+    if (r < 75)
+    {
+        int v = val[ch] + rand() % 7 - 3;   // kleine Änderung
+        return v < 0 ? 0 : v > PWM_STEPS - 1 ? PWM_STEPS - 1 : v;
+    }
+    return rand() % PWM_STEPS;
+}
+
+static void exhaustive(void)
+{
+    uint8_t val[PWM_CHANNELS] = { 0 };
+    unsigned long n = 0;
+    uint8_t ch;
+
+    for (;;)
+    {
+        transition(val, 0, NULL);
+        n++;
+        for (ch = 0; ch < PWM_CHANNELS && ++val[ch] == (uint8_t)PWM_STEPS; ch++)
+            val[ch] = 0;
+        if (ch == PWM_CHANNELS)
+            break;
+    }
+    printf("vollständig: %lu Einstellungen\n", n);
+}
+
+static void randomised(unsigned long count)
+{
+    uint8_t val[PWM_CHANNELS], next[PWM_CHANNELS];
+    unsigned long i;
+    uint8_t ch;
+
+    memcpy(val, active, PWM_CHANNELS);
+    for (i = 0; i < count; i++)
+    {
+        for (ch = 0; ch < PWM_CHANNELS; ch++)
+            val[ch] = pick(val, ch);
+        if (rand() % 4 == 0)
+        {
+            /* Zweite Veröffentlichung mitten im Zyklus (Flanke 1..Kanäle+1) */
+            for (ch = 0; ch < PWM_CHANNELS; ch++)
+                next[ch] = pick(val, ch);
+            transition(val, 1 + rand() % (PWM_CHANNELS + 1), next);
+        }
+        else
+            transition(val, 0, NULL);
+    }
+    printf("zufällig: %lu Folgen\n", count);
+}
+
+/* Mittlere Dauer von pwm_update() für eine Folge von Einstellungen (ohne ISR) */
+static void timing(const char *name, uint8_t (*gen)(unsigned long i, uint8_t ch))
+{
+    const unsigned long count = 1UL << 20;
+    static uint8_t seq[1UL << 20][PWM_CHANNELS];
+    unsigned long i;
+    uint8_t ch;
+    double best = 1e30;
+    int round;
+
+    for (i = 0; i < count; i++)
+        for (ch = 0; ch < PWM_CHANNELS; ch++)
+            seq[i][ch] = gen(i, ch);
+    for (round = 0; round < 5; round++)
+    {
+        auto t0 = std::chrono::steady_clock::now();
+        for (i = 0; i < count; i++)
+            update(seq[i]);
+        auto t1 = std::chrono::steady_clock::now();
+        double ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / count;
+        if (ns < best)
+            best = ns;
+    }
+    printf("pwm_update %-12s %6.1f ns je Aufruf\n", name, best);
+}
+
+static uint8_t gen_drawing(unsigned long i, uint8_t ch)
+{
+    return 40 + (uint8_t)((i / (8 + ch)) % 60) + ch * 30;
+}
+
+static uint8_t gen_random(unsigned long, uint8_t)
+{
+    return rand() % PWM_STEPS;
+}
+
+static uint8_t gen_equal(unsigned long i, uint8_t)
+{
+    return (i & 1) ? 75 : 76;
+}
+
+static uint8_t gen_zero(unsigned long, uint8_t)
+{
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    unsigned long count = 200000;
+    int full = 1, a = 1;
+
+    if (a < argc && !strcmp(argv[a], "-q"))
+    {
+        full = 0;
+        a++;
+    }
+    if (a < argc)
+        count = strtoul(argv[a], NULL, 10);
+
+    srand(1);
+    pwm_init();
+    if (full)
+        exhaustive();
+    randomised(count);
+    printf("%lu Zyklen geprüft, %lu Abweichungen\n", cycles, failures);
+
+    timing("zeichnend", gen_drawing);
+    timing("zufällig", gen_random);
+    timing("gleich", gen_equal);
+    timing("aus", gen_zero);
+    return failures != 0;
+}
@@ -0,0 +1,119 @@
+/* Prüfstand für das Bewegungsmodell (servo.h) auf dem PC: die PWM-Zyklen
+   werden von Hand weitergezählt, servo_move() bekommt Folgen wie beim
+   Zeichnen und beim Streamen vom PC (ein Kommando je Zyklus).
+
+   Geprüft wird, dass ein neues Kommando die laufende Bewegung ersetzt und
+   nicht hinter ihr eingereiht wird:
+   - je Zyklus ein Schritt von 1° hin und her bzw. eine Rampe über 180°:
+     die gemeldete Dauer ist die eines einzelnen Schritts, nach dem
+     letzten Kommando ist das Servo danach ruhig (servo_busy), egal wie
+     viele vorausgingen;
+   - eine große Bewegung, nach der halben Stellzeit zurück zur Mitte
+     kommandiert: gerechnet wird von der erreichten Lage aus.
+
+   Übersetzen (im Hauptverzeichnis):
+     g++ -O2 -DF_CPU=4000000UL -Itools/plotsim -I. -o servocheck \
+         tools/servocheck.cpp servo.cpp calib.cpp stats.cpp pwm.cpp
+   Aufruf:
+     ./servocheck
+   Rückgabe 1 bei Abweichungen. */
+#include <stdio.h>
+#include "servo.h"
+#include "calib.h"
+
+#define SIM_DEFINE8(r)      volatile uint8_t r;
+#define SIM_DEFINE16(r)     volatile uint16_t r;
+SIM_REGISTERS(SIM_DEFINE8, SIM_DEFINE16)
+
+#define MOVES   1000
+
+static int errors;
+
+/* Zyklen bis zur Ruhe nach dem letzten Kommando */
+static unsigned settle(void)
+{
+    unsigned n = 0;
+
+    while (servo_busy() && n < 60000)
+    {
+        pwm_frames++;
+        n++;
+    }
+    return n;
+}
+
+/* count Kommandos, je Zyklus eines, Winkel aus angle(i); jede Meldung
+   muss der Dauer des einzelnen Schritts entsprechen */
+static void sequence(const char *name, uint8_t (*angle)(int i))
+{
+    uint8_t prev = angle(0), next, frames, step, worst = 0;
+    unsigned wait;
+    int i;
+
+    servo_move(SERVO_LEFT, prev);
+    settle();
+    for (i = 1; i <= MOVES; i++)
+    {
+        next = angle(i);
+        step = servo_move_frames(SERVO_LEFT, prev, next);
+        frames = servo_move(SERVO_LEFT, next);
+        if (frames != step)
+        {
+            printf("%s: Kommando %d meldet %u statt %u Zyklen\n", name, i, frames, step);
+            errors++;
+        }
+        if (frames > worst)
+            worst = frames;
+        prev = next;
+        pwm_frames++;
+    }
+    wait = settle() + 1;
+    printf("%-8s %d Kommandos, höchstens %u Zyklen gemeldet, danach %u Zyklen bis zur Ruhe\n",
+           name, MOVES, worst, wait);
+    if (wait > worst)
+    {
+        printf("%s: Wartezeit wächst mit der Folge\n", name);
+        errors++;
+    }
+}
+
+static uint8_t zigzag(int i)
+{
+    return 90 + (i & 1);
+}
+
+static uint8_t ramp(int i)
+{
+    i %= 360;
+    return i < 180 ? i : 359 - i;
+}
+
+int main(void)
+{
+    uint8_t full, frames;
+
+    cal_load();
+    servo_init();
+
+    sequence("1° hin/her", zigzag);
+    sequence("Rampe", ramp);
+
+    /* 0 -> 180°, nach der halben Stellzeit zurück zur Mitte */
+    servo_move(SERVO_LEFT, 0);
+    settle();
+    full = servo_travel_frames(SERVO_LEFT, 0, 180);
+    servo_move(SERVO_LEFT, 180);
+    pwm_frames += full / 2;
+    frames = servo_move(SERVO_LEFT, 90);
+    printf("0 -> 180° (%u Zyklen Stellzeit), nach %u Zyklen -> 90°: %u Zyklen gemeldet\n",
+           full, full / 2, frames);
+    if (frames > servo_move_frames(SERVO_LEFT, 80, 90))
+    {
+        printf("Umkehr rechnet nicht von der erreichten Lage aus\n");
+        errors++;
+    }
+
+    if (!errors)
+        printf("keine Abweichung\n");
+    return errors != 0;
+}
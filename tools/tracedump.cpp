@@ -0,0 +1,118 @@
+/* Auswertung des Ablaufprotokolls (trace.h) auf dem PC.
+
+   Übersetzen:  g++ -O2 -o tracedump tools/tracedump.cpp
+   Aufruf:      stty -F /dev/ttyUSB0 38400 raw -echo
+                ./tracedump < /dev/ttyUSB0       (oder eine Mitschnittdatei)
+
+   Die Zeit eines Eintrags hat nur 8 Bit (1/256 s); die Sekunden werden
+   unter der Annahme mitgezählt, dass zwischen zwei Einträgen weniger als
+   eine Sekunde liegt. Die Firmware leert den ISR-Puffer vor dem des
+   Hauptprogramms, Einträge kommen daher nicht immer in zeitlicher Folge
+   an: ein Rücksprung um weniger als TRACE_REORDER gilt als verspäteter
+   Eintrag, nicht als neue Sekunde. Nach Übertragungsfehlern sucht das Programm die
+   nächste gültige Kennung (0xF0 | Typ) und fährt dort fort. */
+#include <stdio.h>
+#include "../trace.h"
+
+#define TRACE_REORDER   64              // größter Versatz verspäteter Einträge [1/256 s]
+
+static const char *const mode_name[] = { "IDLE", "PWM", "DCF", "STREAM" };
+
+static const char *mode(uint8_t m)
+{
+    return m < sizeof(mode_name) / sizeof(mode_name[0]) ? mode_name[m] : "?";
+}
+
+static int valid(uint8_t id)
+{
+    return (id & 0xF0) == TRACE_MARK && (id & 0x0F) < TRACE_TYPES;
+}
+
+int main(int argc, char **argv)
+{
+    FILE *in = stdin;
+    uint8_t buf[sizeof(TraceRecord)];
+    unsigned n = 0, skipped = 0;
+    unsigned long seconds = 0;
+    int last = -1;
+    int c;
+
+    if (argc > 1 && !(in = fopen(argv[1], "rb")))
+    {
+        perror(argv[1]);
+        return 1;
+    }
+    while ((c = getc(in)) != EOF)
+    {
+        buf[n++] = (uint8_t)c;
+        if (!valid(buf[0]))
+        {
+            n = 0;                      // Kennung suchen
+            skipped++;
+            continue;
+        }
+        if (n < sizeof(buf))
+            continue;
+        n = 0;
+        if (skipped)
+        {
+            printf("# %u Byte übersprungen\n", skipped);
+            skipped = 0;
+        }
+
+        TraceRecord r = { buf[0], buf[1], buf[2], buf[3] };
+        unsigned long second = seconds;
+        if (last >= 0 && (uint8_t)(last - r.time) < TRACE_REORDER)
+        {
+            if (r.time > last && second)
+                second--;               // verspätet aus der vorigen Sekunde
+        }
+        else
+        {
+            if (last >= 0 && r.time < last)
+                seconds++;
+            second = seconds;
+            last = r.time;
+        }
+        // Zeit in 1/256 s (TICKS_PER_SECOND, ticks.h)
+        printf("%6lu.%03u  ", second, (unsigned)(r.time * 1000u / 256u));
+
+        switch (r.id & 0x0F)
+        {
+        case TRACE_DCF:
+            printf("DCF   '%c' nach %u0 ms\n", r.a, r.b);
+            break;
+        case TRACE_SYNC:
+            printf("SYNC  %u -> %u\n", r.b, r.a);
+            break;
+        case TRACE_MODE:
+            printf("MODE  %s -> %s\n", mode(r.b), mode(r.a));
+            break;
+        case TRACE_PWM:
+            printf("PWM   %u Flanken, Satz %u\n", r.a, r.b);
+            break;
+        case TRACE_RTC:
+            printf("RTC   gestellt bei Sekunde %u, Korrektur %+d min\n", r.a, (int8_t)r.b);
+            break;
+        case TRACE_DROP:
+            printf("DROP  %u Einträge im %s-Puffer verworfen\n", r.b, r.a == TRACE_FROM_ISR ? "ISR" : "Haupt");
+            break;
+        case TRACE_LINK:
+            printf("LINK  %u frei, bis Rahmen %u angenommen\n", r.a, r.b);
+            break;
+        case TRACE_UNDERRUN:
+            printf("UNDER %u Fehlzyklen\n", r.a | (r.b << 8));
+            break;
+        case TRACE_QUALITY:
+            if (r.b == 0xFF)
+                printf("QUAL  %u %% gültige Sekunden, keine Minutenmarke\n", r.a);
+            else
+                printf("QUAL  %u %% gültige Sekunden, %u %% Minutenmarken richtig\n", r.a, r.b);
+            break;
+        case TRACE_ISR:
+            printf("ISR   Byte %u = 0x%02X (Auswertung: tools/linkhost.cpp)\n", r.a, r.b);
+            break;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,96 @@
+#include "trace.h"
+
+#ifdef TRACE
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include "ticks.h"
+
+#define TRACE_UBRR  ((F_CPU / (8L * TRACE_BAUD)) - 1)
+
+/* Ringpuffer: head schreibt nur der Erzeuger, tail nur die UDRE-ISR */
+static TraceRecord trace_ring[2][TRACE_RING];
+static volatile uint8_t trace_head[2];
+static volatile uint8_t trace_tail[2];
+static uint8_t trace_pending[2];        // noch nicht gemeldete verworfene Einträge
+
+volatile uint16_t trace_dropped[2];
+
+/* Gerade gesendeter Eintrag (UDRE-ISR) */
+static TraceRecord trace_tx;
+static uint8_t trace_tx_pos = sizeof(TraceRecord);
+
+void trace_init(void)
+{
+    UBRRH = (uint8_t)(TRACE_UBRR >> 8);
+    UBRRL = (uint8_t)TRACE_UBRR;
+    UCSRA = (1 << U2X);
+    UCSRC = (1 << URSEL) | (1 << UCSZ1) | (1 << UCSZ0);
+    UCSRB = (1 << TXEN);                // nur Senden: PD0 bleibt DCF-Eingang
+}
+
+static uint8_t trace_put(uint8_t r, uint8_t id, uint8_t a, uint8_t b)
+{
+    uint8_t head = trace_head[r];
+    uint8_t next = (head + 1) & (TRACE_RING - 1);
+    TraceRecord *rec;
+
+    if (next == trace_tail[r])
+        return 0;
+    rec = &trace_ring[r][head];
+    rec->id = id;
+    rec->time = (uint8_t)ticks_now();
+    rec->a = a;
+    rec->b = b;
+    trace_head[r] = next;               // erst jetzt für die ISR sichtbar
+    return 1;
+}
+
+void trace(uint8_t type, uint8_t a, uint8_t b)
+{
+    uint8_t r = (SREG & (1 << SREG_I)) ? TRACE_FROM_MAIN : TRACE_FROM_ISR;
+    uint8_t used = (trace_head[r] - trace_tail[r]) & (TRACE_RING - 1);
+
+    /* Verlust melden, sobald Platz für Meldung und Eintrag ist */
+    if (trace_pending[r] && used < TRACE_RING - 2)
+    {
+        trace_put(r, TRACE_MARK | TRACE_DROP, r, trace_pending[r]);
+        trace_pending[r] = 0;
+    }
+    if (!trace_put(r, TRACE_MARK | type, a, b))
+    {
+        if (trace_pending[r] != 0xFF)
+            trace_pending[r]++;
+        if (trace_dropped[r] != 0xFFFF)
+            trace_dropped[r]++;
+        return;
+    }
+    UCSRB |= (1 << UDRIE);              // Ausgabe anstoßen (sbi)
+}
+
+uint8_t trace_free(void)
+{
+    return TRACE_RING - 1 - ((trace_head[TRACE_FROM_MAIN] - trace_tail[TRACE_FROM_MAIN]) & (TRACE_RING - 1));
+}
+
+/* Sendepuffer leer: nächstes Byte, ISR-Puffer hat Vorrang */
+ISR(USART_UDRE_vect)
+{
+    uint8_t r;
+
+    if (trace_tx_pos >= sizeof(TraceRecord))
+    {
+        for (r = 0; r < 2 && trace_tail[r] == trace_head[r]; r++);
+        if (r == 2)
+        {
+            UCSRB &= ~(1 << UDRIE);     // nichts mehr zu senden
+            return;
+        }
+        trace_tx = trace_ring[r][trace_tail[r]];
+        trace_tail[r] = (trace_tail[r] + 1) & (TRACE_RING - 1);
+        trace_tx_pos = 0;
+    }
+    UDR = ((const uint8_t *)&trace_tx)[trace_tx_pos++];
+}
+
+#endif // TRACE
@@ -0,0 +1,72 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdint.h>
+
+/* Binäres Ablaufprotokoll über den USART (nur TXD/PD1; RXD bleibt
+   DCF-Eingang). Nur mit -DTRACE übersetzt, sonst sind die Makros leer.
+
+   Ein Eintrag hat 4 Byte: Kennung (0xF0 | Typ), Zeit (untere 8 Bit von
+   ticks_now(), 1/256 s), Daten a, Daten b. Einträge aus ISRs (oder bei
+   gesperrten Interrupts) und aus dem Hauptprogramm landen in getrennten
+   Ringpuffern mit je einem Schreiber und einem Leser; die UDRE-ISR leert
+   beide. Schreiben blockiert nie: ist ein Puffer voll, wird der Eintrag
+   verworfen und gezählt. Sobald wieder Platz ist, meldet ein TRACE_DROP
+   die Anzahl der verworfenen Einträge.
+
+   Auswertung auf dem PC: tools/tracedump.cpp */
+#define TRACE_BAUD      38400           // mit U2X: 0,2 % Fehler bei 4 MHz
+#define TRACE_RING      16              // Einträge je Puffer (Zweierpotenz)
+#define TRACE_MARK      0xF0
+
+/* Typen der Einträge (a, b) */
+typedef enum
+{
+    TRACE_DCF   = 0,                    // DCF-Ereignis: Zeichen ('0', '1', 'm', 'e'), 10-ms-Zähler
+    TRACE_SYNC  = 1,                    // Synchronisationsstatus: neu, alt
+    TRACE_MODE  = 2,                    // Betriebsart (SystemMode): neu, alt
+    TRACE_PWM   = 3,                    // PWM-Satz veröffentlicht: Anzahl Flanken, Version
+    TRACE_RTC   = 4,                    // RTC nach DCF gestellt: alte Sekunde, Minutenkorrektur (int8)
+    TRACE_DROP  = 5,                    // verworfene Einträge: Puffer (0 ISR, 1 Haupt), Anzahl
+    TRACE_LINK  = 6,                    // Gutschrift (link.h): freie Plätze, zuletzt angenommene Folgenummer
+    TRACE_UNDERRUN = 7,                 // Fehlzyklus beim Zeichnen vom PC: Anzahl low, high
+    TRACE_QUALITY = 8,                  // DCF-Empfangsfenster (dcf77.h): gültige Sekunden [%], Minutenmarken an der erwarteten Stelle [%] (0xFF keine)
+    TRACE_ISR   = 9,                    // ISR-Statistik auf Anforderung (LINK_ISR): Position, Byte (isrstat.h)
+    TRACE_TYPES
+} TraceType;
+
+/* Puffer */
+#define TRACE_FROM_ISR  0
+#define TRACE_FROM_MAIN 1
+
+typedef struct
+{
+    uint8_t id;                         // TRACE_MARK | TraceType
+    uint8_t time;
+    uint8_t a, b;
+} TraceRecord;
+
+#ifdef TRACE
+
+#define TRACE_EVENT(type, a, b)     trace((type), (a), (b))
+
+/* Verworfene Einträge je Puffer seit dem Start (bleibt bei 0xFFFF stehen) */
+extern volatile uint16_t trace_dropped[2];
+
+/* USART für die Ausgabe einrichten (8N1, TRACE_BAUD) */
+void trace_init(void);
+
+/* Schreibt einen Eintrag; aus ISRs und aus dem Hauptprogramm aufrufbar.
+   Der Puffer wird am I-Bit erkannt: gesperrte Interrupts -> ISR-Puffer */
+void trace(uint8_t type, uint8_t a, uint8_t b);
+
+/* Freie Plätze im Puffer des Hauptprogramms (für längere Ausgaben) */
+uint8_t trace_free(void);
+
+#else
+
+#define TRACE_EVENT(type, a, b)     ((void)0)
+
+#endif // TRACE
+
+#endif // TRACE_H
@@ -0,0 +1,142 @@
+#include "warm.h"
+#include <avr/eeprom.h>
+#include <util/crc16.h>
+#include <stddef.h>
+#include "ticks.h"
+
+/* Ein Platz im EEPROM */
+typedef struct
+{
+    uint8_t  version;
+    uint16_t seq;                       // Folgenummer, der jüngste Platz hat die größte
+    uint8_t  hours;
+    uint8_t  minutes;
+    int16_t  drift;
+    uint8_t  crc;                       // CRC-8 über alle Felder davor
+} WarmSlot;
+
+static WarmSlot warm_eeprom[WARM_SLOTS] EEMEM;
+
+int16_t warm_drift;
+
+#define WARM_SECOND         16000000L   // eine Sekunde in 1/16 µs
+
+/* Halbe Nachführung je 1/256 s Abweichung und Sekunde Messdauer [1/16 ppm] */
+#define WARM_DRIFT_SCALE    (WARM_SECOND / 2 / TICKS_PER_SECOND)
+static_assert(WARM_ERROR_MAX * WARM_DRIFT_SCALE < 0x7FFFFFFFL - 0x7FFFL, "Nachführung der Gangabweichung läuft in 32 Bit über");
+
+static uint8_t warm_slot;               // zuletzt geschriebener Platz
+static uint16_t warm_seq;
+static uint8_t warm_minutes;
+static uint8_t warm_valid;              // Uhrzeit bekannt (gesichert oder empfangen)
+static uint8_t warm_locked;             // seit dem Einschalten synchronisiert
+static uint32_t warm_sync_ticks;        // Zeitpunkt der letzten Synchronisation
+static int32_t warm_phase;              // aufgelaufene Abweichung seit der letzten Korrektur [1/16 µs]
+
+static uint8_t warm_crc(const WarmSlot *slot)
+{
+    const uint8_t *p = (const uint8_t *)slot;
+    uint8_t crc = 0;
+    uint8_t i;
+
+    for (i = 0; i < offsetof(WarmSlot, crc); i++)
+        crc = _crc8_ccitt_update(crc, p[i]);
+    return crc;
+}
+
+uint8_t warm_load(uint8_t *hours, uint8_t *minutes)
+{
+    WarmSlot slot;
+    uint8_t i;
+
+    for (i = 0; i < WARM_SLOTS; i++)
+    {
+        eeprom_read_block(&slot, &warm_eeprom[i], sizeof(slot));
+        if (slot.version != WARM_VERSION || slot.crc != warm_crc(&slot) ||
+                slot.hours >= 24 || slot.minutes >= 60)
+            continue;
+        if (!warm_valid || (int16_t)(slot.seq - warm_seq) > 0)
+        {
+            warm_valid = 1;
+            warm_slot = i;
+            warm_seq = slot.seq;
+            *hours = slot.hours;
+            *minutes = slot.minutes;
+            warm_drift = slot.drift;
+        }
+    }
+    if (!warm_valid)
+        warm_slot = WARM_SLOTS - 1;     // erste Sicherung in Platz 0
+    return warm_valid;
+}
+
+void warm_minute(void)
+{
+    if (warm_minutes < WARM_SAVE_MINUTES)
+        warm_minutes++;
+}
+
+void warm_idle(uint8_t hours, uint8_t minutes)
+{
+    WarmSlot slot;
+
+    if (!warm_valid || warm_minutes < WARM_SAVE_MINUTES)
+        return;
+    warm_minutes = 0;
+
+    if (++warm_slot >= WARM_SLOTS)
+        warm_slot = 0;
+    slot.version = WARM_VERSION;
+    slot.seq = ++warm_seq;
+    slot.hours = hours;
+    slot.minutes = minutes;
+    slot.drift = warm_drift;
+    slot.crc = warm_crc(&slot);
+    eeprom_update_block(&slot, &warm_eeprom[warm_slot], sizeof(slot));
+}
+
+void warm_synced(int32_t error)
+{
+    uint32_t now = ticks_now();
+    uint32_t elapsed = now - warm_sync_ticks;
+    int32_t drift, seconds;
+
+    /* Nur über genügend lange, ununterbrochene Strecken messen; die
+       Abweichung ist der Rest nach der bisherigen Korrektur */
+    if (warm_locked && elapsed >= WARM_DRIFT_HOURS * 3600UL * TICKS_PER_SECOND &&
+            error > -WARM_ERROR_MAX && error < WARM_ERROR_MAX)
+    {
+        /* error / elapsed in 1/16 ppm, zur Hälfte: error * 8e6 / elapsed;
+           elapsed in ganzen Sekunden (der Rest ist bei mindestens
+           WARM_DRIFT_HOURS vernachlässigbar), gerundet */
+        seconds = elapsed / TICKS_PER_SECOND;
+        drift = error * WARM_DRIFT_SCALE;
+        drift = (drift + (drift < 0 ? -seconds / 2 : seconds / 2)) / seconds + warm_drift;
+        if (drift > WARM_DRIFT_MAX)
+            drift = WARM_DRIFT_MAX;
+        if (drift < -WARM_DRIFT_MAX)
+            drift = -WARM_DRIFT_MAX;
+        warm_drift = (int16_t)drift;
+    }
+    warm_locked = 1;
+    warm_valid = 1;
+    warm_sync_ticks = now;
+    warm_phase = 0;
+    warm_minutes = WARM_SAVE_MINUTES;   // beim nächsten Leerlauf sichern
+}
+
+uint8_t warm_second(void)
+{
+    warm_phase += warm_drift;
+    if (warm_phase >= WARM_SECOND)
+    {
+        warm_phase -= WARM_SECOND;
+        return 0;                       // RTC geht vor: Sekunde auslassen
+    }
+    if (warm_phase <= -WARM_SECOND)
+    {
+        warm_phase += WARM_SECOND;
+        return 2;                       // RTC geht nach: Sekunde nachholen
+    }
+    return 1;
+}
@@ -0,0 +1,53 @@
+#ifndef WARM_H
+#define WARM_H
+
+#include <stdint.h>
+
+/* Warmstart nach Reset oder Stromausfall, Gangabweichung der RTC.
+   Im Leerlauf sichert warm_idle() alle WARM_SAVE_MINUTES Minuten und nach
+   jeder DCF-Synchronisation Uhrzeit und geschätzte Gangabweichung, reihum
+   über WARM_SLOTS Plätze mit Folgenummer und CRC-8 (wie stats.h). Nach dem
+   Einschalten zeigt die Uhr sofort den gesicherten Stand, und der Decoder
+   übernimmt die DCF-Zeit schon nach Bit 35 der ersten Minute (dcf_expect),
+   wenn sie höchstens WARM_WINDOW Minuten davon abweicht.
+
+   Die Sekundenphase übersteht keinen Reset (Timer2 beginnt neu); sie wird
+   bei der Übernahme aus der Minutenmarke bzw. dem Impuls von Bit 35 gesetzt.
+
+   Gangabweichung: bei jeder Synchronisation wird die Abweichung der RTC
+   (1/256 s) auf die Zeit seit der vorigen bezogen (mindestens
+   WARM_DRIFT_HOURS Stunden im selben Betrieb) und die Schätzung zur Hälfte
+   nachgeführt; warm_second() gleicht sie mit ausgelassenen bzw. doppelt
+   gezählten Sekunden aus.
+
+   Lebensdauer: 288 Sicherungen am Tag verteilt auf 16 Plätze ergeben
+   ca. 6600 Schreibzyklen je Zelle und Jahr (EEPROM: 100 000). */
+#define WARM_SLOTS          16
+#define WARM_SAVE_MINUTES   5
+#define WARM_WINDOW         60          // zulässige Abweichung beim Warmstart [min]
+#define WARM_DRIFT_HOURS    4
+#define WARM_DRIFT_MAX      (200 * 16)  // Grenze der Schätzung [1/16 ppm]
+#define WARM_ERROR_MAX      (60L * 256) // größere Abweichungen sind kein Gang [1/256 s]
+#define WARM_VERSION        1           // Kennung des EEPROM-Formats
+
+/* Geschätzte Gangabweichung der RTC [1/16 ppm, positiv: RTC geht vor] */
+extern int16_t warm_drift;
+
+/* Lädt den jüngsten gültigen Stand; liefert 0, wenn keiner vorhanden ist */
+uint8_t warm_load(uint8_t *hours, uint8_t *minutes);
+
+/* Zählt Minuten bis zur nächsten Sicherung (beim Minutenwechsel aufrufen) */
+void warm_minute(void);
+
+/* Sichert die Uhrzeit, falls fällig und bekannt; nur im Leerlauf aufrufen
+   (ca. 4 geänderte Byte à 8,5 ms) */
+void warm_idle(uint8_t hours, uint8_t minutes);
+
+/* Nach einer DCF-Synchronisation: error = RTC minus DCF-Zeit [1/256 s] */
+void warm_synced(int32_t error);
+
+/* Einmal je RTC-Sekunde: um so viele Sekunden ist die Uhr weiterzustellen
+   (1; bei vorgehender RTC gelegentlich 0, bei nachgehender 2) */
+uint8_t warm_second(void);
+
+#endif // WARM_H